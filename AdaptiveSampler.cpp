@@ -0,0 +1,149 @@
+/*
+ *  AdaptiveSampler.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "AdaptiveSampler.h"
+
+AdaptiveSampler::AdaptiveSampler(int aThreshold, byte aMaxInterval, byte aQuietFrames)
+  : _Threshold(aThreshold)
+{
+  SetMaxInterval(aMaxInterval);
+  SetQuietFrames(aQuietFrames);
+  Reset();
+}
+
+void AdaptiveSampler::Reset()
+{
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+    Reset(i);
+
+  _Conversions      = 0;
+  _ConversionsSaved = 0;
+}
+
+void AdaptiveSampler::Reset(byte aIndex)
+{
+  if(aIndex >= MAX_NUM_ANALOGUE_INPUTS)
+    return;
+
+  _Intervals[aIndex]  = 1;
+  _Countdowns[aIndex] = 0;
+  _QuietRuns[aIndex]  = 0;
+  _Previous[aIndex]   = 0;
+
+  _Pending &= ~(1 << aIndex);
+  _Seen    &= ~(1 << aIndex);
+}
+
+void AdaptiveSampler::SaveState(SamplerState& aState)
+{
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    aState.Intervals[i] = _Intervals[i];
+    aState.QuietRuns[i] = _QuietRuns[i];
+    aState.Previous[i]  = _Previous[i];
+  }
+
+  aState.Seen = _Seen;
+}
+
+void AdaptiveSampler::RestoreState(const SamplerState& aState)
+{
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    byte interval = aState.Intervals[i];
+    _Intervals[i]  = interval == 0 ? 1 : interval > _MaxInterval ? _MaxInterval : interval;
+    _QuietRuns[i]  = aState.QuietRuns[i];
+    _Previous[i]   = aState.Previous[i];
+    _Countdowns[i] = 0;
+  }
+
+  _Seen    = aState.Seen;
+  _Pending = 0;
+}
+
+byte AdaptiveSampler::Due(byte aCount, byte aSensors)
+{
+  byte mask = 0;
+
+  for(byte i=0; i<aCount; i++)
+  {
+    if(!(aSensors & (1 << i)))
+      continue;
+
+    if(_Countdowns[i] <= 1)
+    {
+      mask |= 1 << i;
+      _Countdowns[i] = _Intervals[i];
+      _Conversions++;
+    }
+    else
+    {
+      _Countdowns[i]--;
+      _ConversionsSaved++;
+    }
+  }
+
+  _Pending = mask;
+  return mask;
+}
+
+void AdaptiveSampler::Update(const int aNormalized[], byte aCount, byte aNormalizedMask)
+{
+  for(byte i=0; i<aCount; i++)
+  {
+    byte bit = 1 << i;
+    if(!(_Pending & bit))
+      continue;
+
+    // A stale reading would look quiet; try again next frame instead.
+    if(!(aNormalizedMask & bit))
+    {
+      _Countdowns[i] = 1;
+      continue;
+    }
+
+    long delta = (long)aNormalized[i] - _Previous[i];
+    if(delta < 0)
+      delta = -delta;
+
+    _Previous[i] = aNormalized[i];
+
+    if(!(_Seen & bit))
+    {
+      _Seen |= bit;
+      continue;
+    }
+
+    if(delta > _Threshold)
+    {
+      // Back to full rate at once.
+      _Intervals[i]  = 1;
+      _Countdowns[i] = 1;
+      _QuietRuns[i]  = 0;
+    }
+    else if(++_QuietRuns[i] >= _QuietFrames)
+    {
+      _QuietRuns[i] = 0;
+
+      unsigned int longer = _Intervals[i] * 2;
+      _Intervals[i] = longer > _MaxInterval ? _MaxInterval : longer;
+    }
+  }
+
+  _Pending = 0;
+}
+
@@ -0,0 +1,137 @@
+//
+//  AdaptiveSampler.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef ADAPTIVE_SAMPLER_H
+#define ADAPTIVE_SAMPLER_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+//
+// What a sampler has learned about each sensor, as saved by SaveState().
+//
+struct SamplerState
+{
+  byte Intervals[MAX_NUM_ANALOGUE_INPUTS];
+  byte QuietRuns[MAX_NUM_ANALOGUE_INPUTS];
+  int Previous[MAX_NUM_ANALOGUE_INPUTS];
+  byte Seen;
+};
+
+//
+// SUMMARY
+//
+// Decides, frame by frame, which sensors DataNormalizer::Read() converts.
+//
+// PURPOSE
+//
+// When the scene is still (at night, under overcast) converting every sensor
+// on every frame spends time and power to learn nothing new. The sampler
+// lowers the rate of each quiet sensor and restores it as soon as the
+// sensor changes.
+//
+// USE
+//
+// A sensor is quiet when consecutive normalized readings differ by no more
+// than the threshold. After QuietFrames quiet samples in a row its interval
+// doubles, up to MaxInterval frames. The first reading that differs by more
+// than the threshold drops the interval straight back to 1.
+//
+// A sensor that is skipped keeps its previous Values and Normalized entries.
+// A change is therefore noticed at most MaxInterval frames late.
+//
+// EXAMPLE
+//
+// AdaptiveSampler Sampler(2, 16, 4);  // 0.2 f/stop; every 16th frame at worst
+// Sensors.AttachSampler(&Sampler);
+//
+class AdaptiveSampler
+{
+  public:
+    AdaptiveSampler(int aThreshold = 1, byte aMaxInterval = 8, byte aQuietFrames = 4);
+
+    void SetThreshold(int aThreshold) { _Threshold = aThreshold; }
+    void SetMaxInterval(byte aMaxInterval) { _MaxInterval = aMaxInterval ? aMaxInterval : 1; }
+    void SetQuietFrames(byte aQuietFrames) { _QuietFrames = aQuietFrames ? aQuietFrames : 1; }
+
+    //
+    // Returns a bit mask of the sensors to convert in this frame, and counts
+    // down the others. Called by DataNormalizer::Read().
+    //
+    // Only the sensors in aSensors are considered; disabled sensors and
+    // empty slots are neither converted nor counted.
+    //
+    byte Due(byte aCount, byte aSensors = 0xFF);
+
+    //
+    // Adjusts the intervals of the sensors converted in this frame, given
+    // their new normalized readings. Called by DataNormalizer::Normalize().
+    //
+    // aNormalizedMask holds the sensors actually normalized in this frame.
+    // A sensor converted but not normalized (shed by an OverloadController)
+    // has no new reading to judge: its quiet count and previous reading are
+    // left alone and it comes due again on the next frame.
+    //
+    void Update(const int aNormalized[], byte aCount, byte aNormalizedMask = 0xFF);
+
+    // The current interval of sensor aIndex, in frames.
+    byte Interval(byte aIndex) { return _Intervals[aIndex]; }
+
+    // Conversions made and conversions skipped.
+    unsigned long Conversions() { return _Conversions; }
+    unsigned long ConversionsSaved() { return _ConversionsSaved; }
+
+    // Returns every sensor to full rate and zeroes the counts.
+    void Reset();
+
+    //
+    // Forgets what has been learned about sensor aIndex alone, for when its
+    // reader or calibration changes: it returns to full rate and its next
+    // reading is taken as its first. The counts are kept.
+    //
+    void Reset(byte aIndex);
+
+    //
+    // Copies the learned intervals into aState, or restores them. Every
+    // sensor is converted on the first frame after RestoreState(), then
+    // continues at its restored interval. Counts are not included.
+    //
+    void SaveState(SamplerState& aState);
+    void RestoreState(const SamplerState& aState);
+
+  private:
+    int _Threshold;
+    byte _MaxInterval;
+    byte _QuietFrames;
+
+    byte _Intervals[MAX_NUM_ANALOGUE_INPUTS];
+    byte _Countdowns[MAX_NUM_ANALOGUE_INPUTS];
+    byte _QuietRuns[MAX_NUM_ANALOGUE_INPUTS];
+    int _Previous[MAX_NUM_ANALOGUE_INPUTS];
+
+    // Sensors returned by the latest Due() and not yet passed to Update().
+    byte _Pending;
+
+    // Sensors that have been sampled at least once.
+    byte _Seen;
+
+    unsigned long _Conversions;
+    unsigned long _ConversionsSaved;
+};
+
+#endif // ADAPTIVE_SAMPLER_H
+
@@ -0,0 +1,63 @@
+/*
+ *  AsyncAnalogRead.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "AsyncAnalogRead.h"
+
+#if defined(__AVR__)
+
+void AvrAnalogRead::StartConversion()
+{
+  // Accept either A0..A5 or 0..5, as analogRead() does.
+  byte channel = PinNumber();
+  if(channel >= 14)
+    channel -= 14;
+
+  ADMUX = (ADMUX & 0xF0) | (channel & 0x07);
+  ADCSRA |= _BV(ADSC);
+}
+
+int AvrAnalogRead::FinishConversion()
+{
+  while(bit_is_set(ADCSRA, ADSC))
+    ;
+
+  // ADCL must be read first; doing so latches ADCH.
+  byte low  = ADCL;
+  byte high = ADCH;
+
+  return (high << 8) | low;
+}
+
+#endif // __AVR__
+
+int SimulatedAnalogRead::_HeldSample = 0;
+
+void SimulatedAnalogRead::StartConversion()
+{
+  _Started = micros();
+}
+
+int SimulatedAnalogRead::FinishConversion()
+{
+  while(micros() - _Started < _ConversionMicros)
+    ;
+
+  _Conversions++;
+  _HeldSample = _Value + ((long)(_HeldSample - _Value) * _Carryover) / 256;
+  return _HeldSample;
+}
+
@@ -0,0 +1,117 @@
+//
+//  AsyncAnalogRead.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef ASYNC_ANALOG_READ_H
+#define ASYNC_ANALOG_READ_H
+
+#include "Arduino.h"
+#include <BaseAnalogRead.h>
+
+//
+// SUMMARY
+//
+// A sensor reader whose conversion can be started and collected separately.
+//
+// PURPOSE
+//
+// An analogue conversion takes about 100us on the Uno, during which
+// analogRead() simply waits. A DataNormalizer configured with these readers
+// starts the conversion for the next sensor and then normalizes the current
+// one while the ADC is busy, so that a frame takes roughly as long as the
+// conversions alone.
+//
+// USE
+//
+// StartConversion() must be followed by FinishConversion() before another
+// conversion is started on any reader sharing the same ADC.
+//
+class AsyncAnalogRead : public BaseAnalogRead
+{
+  public:
+    AsyncAnalogRead(byte aPinNumber) : BaseAnalogRead(aPinNumber) {}
+
+    // Begins a conversion and returns at once.
+    virtual void StartConversion() = 0;
+
+    // Waits for the conversion begun by StartConversion() and returns it.
+    virtual int FinishConversion() = 0;
+
+    virtual int Read() { StartConversion(); return FinishConversion(); }
+};
+
+#if defined(__AVR__)
+
+//
+// Drives the ATmega328's own ADC directly.
+//
+// The reference voltage selected in ADMUX is left as it is, so
+// analogReference() should be called before use, as for analogRead().
+//
+class AvrAnalogRead : public AsyncAnalogRead
+{
+  public:
+    AvrAnalogRead(byte aPinNumber) : AsyncAnalogRead(aPinNumber) {}
+
+    virtual void StartConversion();
+    virtual int FinishConversion();
+};
+
+#endif // __AVR__
+
+//
+// A stand-in for a real sensor, for trying out acquisition schemes without
+// the hardware or off the Arduino altogether.
+//
+// Each conversion takes ConversionMicros to complete, measured from
+// StartConversion(), and returns whatever was last given to SetValue().
+//
+// All simulated readers share one model sample-and-hold capacitor. A
+// reader with a non-zero carryover (a high-impedance source) keeps that
+// fraction, in 256ths, of the difference between the previous conversion
+// and its own value, as a real ADC does when the source cannot recharge
+// the capacitor in time. This lets ScanPlanner settings be judged off the
+// device.
+//
+class SimulatedAnalogRead : public AsyncAnalogRead
+{
+  public:
+    SimulatedAnalogRead(byte aPinNumber, unsigned int aConversionMicros)
+      : AsyncAnalogRead(aPinNumber), _ConversionMicros(aConversionMicros), _Carryover(0), _Value(0), _Started(0), _Conversions(0) {}
+
+    void SetValue(int aValue) { _Value = aValue; }
+    void SetConversionMicros(unsigned int aMicros) { _ConversionMicros = aMicros; }
+    void SetCarryover(byte aPer256) { _Carryover = aPer256; }
+
+    // The number of conversions performed so far.
+    unsigned long Conversions() { return _Conversions; }
+
+    virtual void StartConversion();
+    virtual int FinishConversion();
+
+  private:
+    // The voltage left on the shared model capacitor, in raw counts.
+    static int _HeldSample;
+
+    unsigned int _ConversionMicros;
+    byte _Carryover;
+    int _Value;
+    unsigned long _Started;
+    unsigned long _Conversions;
+};
+
+#endif // ASYNC_ANALOG_READ_H
+
@@ -0,0 +1,83 @@
+/*
+ *  CompensationMemo.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "CompensationMemo.h"
+
+CompensationMemo::CompensationMemo()
+  : _Entries(NULL), _Capacity(0), _Mask(0), _Ready(true), _Occupied(0), _Hits(0), _Misses(0), _Evictions(0)
+{
+}
+
+bool CompensationMemo::configure(MemoEntry aEntries[], unsigned int aCapacity)
+{
+  if(aEntries == NULL || aCapacity == 0 || (aCapacity & (aCapacity - 1)))
+    return false;
+
+  _Entries  = aEntries;
+  _Capacity = aCapacity;
+  _Mask     = aCapacity - 1;
+
+  Clear();
+  return true;
+}
+
+void CompensationMemo::Clear()
+{
+  for(unsigned int i=0; i<_Capacity; i++)
+    _Entries[i].Raw = MEMO_EMPTY;
+
+  _Occupied  = 0;
+  _Hits      = 0;
+  _Misses    = 0;
+  _Evictions = 0;
+}
+
+bool CompensationMemo::Find(int aRaw, int* aValue, int* aSegment)
+{
+  if(_Entries == NULL)
+    return false;
+
+  MemoEntry* entry = &_Entries[aRaw & _Mask];
+  if(entry->Raw != aRaw || aRaw == MEMO_EMPTY)
+  {
+    _Misses++;
+    return false;
+  }
+
+  _Hits++;
+  *aValue   = entry->Value;
+  *aSegment = entry->Segment;
+  return true;
+}
+
+void CompensationMemo::Store(int aRaw, int aValue, int aSegment)
+{
+  if(_Entries == NULL || aRaw == MEMO_EMPTY)
+    return;
+
+  MemoEntry* entry = &_Entries[aRaw & _Mask];
+
+  if(entry->Raw == MEMO_EMPTY)
+    _Occupied++;
+  else if(entry->Raw != aRaw)
+    _Evictions++;
+
+  entry->Raw     = aRaw;
+  entry->Value   = aValue;
+  entry->Segment = aSegment;
+}
+
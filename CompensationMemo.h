@@ -0,0 +1,126 @@
+//
+//  CompensationMemo.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef COMPENSATION_MEMO_H
+#define COMPENSATION_MEMO_H
+
+#include "Arduino.h"
+
+// The raw value that marks an unused entry. A reading of exactly this value
+// is never remembered.
+const int MEMO_EMPTY = -32768;
+
+//
+// One remembered result: the normalized value and segment for a raw value.
+//
+struct MemoEntry
+{
+  int Raw;
+  int Value;
+  char Segment;
+};
+
+//
+// SUMMARY
+//
+// Remembers the normalized value of each raw reading a sensor has produced.
+//
+// PURPOSE
+//
+// A complete lookup table costs as many entries as the ADC has codes, and
+// building one for every sensor up front takes time and memory that is
+// mostly wasted: a given sensor only ever visits a narrow band of readings.
+// The memo starts empty, is filled in as readings arrive, and serves every
+// repeat from the table.
+//
+// USE
+//
+// The caller supplies the entries; their number must be a power of two.
+// Raw values map onto entries by their low bits. With at least as many
+// entries as raw codes (1024 for the Uno's ADC) every reading has its own
+// entry and the memo becomes a lazily built lookup table. With fewer, for
+// wide raw domains or small memories, readings that share low bits evict
+// one another, so memory stays bounded at some cost in hits.
+//
+// The memo must be cleared whenever its sensor's calibration changes;
+// DataNormalizer::configure() does this for attached memos.
+//
+// A memo that is not Ready() is ignored by the normalizer, which uses the
+// plain search and interpolation instead. TableBuilder uses this to fill a
+// memo in the background and hand it over only once it is complete.
+//
+// EXAMPLE
+//
+// MemoEntry Entries[256];
+// CompensationMemo Memo;
+//
+// Memo.configure(Entries, 256);
+// Sensors.AttachMemo(0, &Memo);
+//
+class CompensationMemo
+{
+  public:
+    CompensationMemo();
+
+    //
+    // aEntries  - storage for the remembered results.
+    // aCapacity - the number of elements in aEntries; a power of two.
+    //
+    // Returns false if the storage is unsuitable.
+    //
+    bool configure(MemoEntry aEntries[], unsigned int aCapacity);
+
+    //
+    // Looks up aRaw. On a hit, sets *aValue and *aSegment and returns true.
+    //
+    bool Find(int aRaw, int* aValue, int* aSegment);
+
+    // Remembers the result for aRaw, evicting whatever shared its entry.
+    void Store(int aRaw, int aValue, int aSegment);
+
+    // Forgets everything and zeroes the counts.
+    void Clear();
+
+    unsigned int Capacity() { return _Capacity; }
+
+    // Whether the normalizer may use the memo. True unless a builder is
+    // filling it.
+    bool Ready() { return _Ready; }
+    void SetReady(bool aReady) { _Ready = aReady; }
+
+    // The number of entries in use, and the same as a percentage.
+    unsigned int Occupied() { return _Occupied; }
+    byte Occupancy() { return _Capacity ? (unsigned long)_Occupied * 100 / _Capacity : 0; }
+
+    unsigned long Hits() { return _Hits; }
+    unsigned long Misses() { return _Misses; }
+    unsigned long Evictions() { return _Evictions; }
+
+  private:
+    MemoEntry* _Entries;
+    unsigned int _Capacity;
+    unsigned int _Mask;
+    volatile bool _Ready;
+
+    unsigned int _Occupied;
+    unsigned long _Hits;
+    unsigned long _Misses;
+    unsigned long _Evictions;
+};
+
+#endif // COMPENSATION_MEMO_H
+
@@ -16,6 +16,26 @@
  */
 
 #include "DataNormalizer.h"
+#include "AdaptiveSampler.h"
+#include "AsyncAnalogRead.h"
+#include "CompensationMemo.h"
+#include "DerivedChannels.h"
+#include "NormalizerMetrics.h"
+#include "OverloadController.h"
+#include "PackedSamples.h"
+#include "ScanPlanner.h"
+#include "SegmentProfile.h"
+
+DataNormalizer::DataNormalizer()
+  : _ActiveCount(0), _Enabled(0), _StatusCode(F_Uninitialized), _Present(0), _Pipelined(false),
+    _Metrics(NULL), _Planner(NULL), _Sampler(NULL), _Overload(NULL), _Sheddable(0), _ShedPhase(0), _Derived(NULL)
+{
+  for(int i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    _Hot[i].Memo    = NULL;
+    _Hot[i].Profile = NULL;
+  }
+}
 
 //
 // Normalize the data for a particular reading.
@@ -23,10 +43,11 @@
 // aValue - The reading.
 // aVector - The vector of readings to use.
 // aIndex - Where to cache the index for aVector.
+// aProfile - The search order to use, or NULL for the plain search.
 //
-int DataNormalizer::Compensate(int aValue, const int* aVector, int* aIndex)
+int DataNormalizer::Compensate(int aValue, const int* aVector, int* aIndex, SegmentProfile* aProfile)
 {
-  *aIndex = FindPosition(aValue, aVector);
+  *aIndex = aProfile ? aProfile->FindPosition(aValue, aVector, _VectorSize) : FindPosition(aValue, aVector);
 
   if(*aIndex < 0)
   {
@@ -36,12 +57,140 @@ int DataNormalizer::Compensate(int aValue, const int* aVector, int* aIndex)
   else if(*aIndex >= _VectorSize)
   {
     *aIndex = SEGMENT_INDEX_HIGH;
-    return _NormalizedVector[_VectorSize];
+    return _NormalizedVector[_VectorSize-1];
   }
   
   return map(aValue, aVector[*aIndex], aVector[*aIndex+1], _NormalizedVector[*aIndex], _NormalizedVector[*aIndex+1]);
 }
 
+//
+// Normalize the latest reading of one sensor.
+//
+// aIndex - The sensor.
+//
+int DataNormalizer::CompensateSensor(byte aIndex)
+{
+  SensorState& sensor = _Hot[aIndex];
+  CompensationMemo* memo = sensor.Memo;
+  if(memo == NULL || !memo->Ready())
+    return Compensate(Values[aIndex], sensor.Calibration, &sensor.SegmentBase, sensor.Profile);
+
+  int value;
+  if(memo->Find(Values[aIndex], &value, &sensor.SegmentBase))
+    return value;
+
+  value = Compensate(Values[aIndex], sensor.Calibration, &sensor.SegmentBase, sensor.Profile);
+  memo->Store(Values[aIndex], value, sensor.SegmentBase);
+  return value;
+}
+
+bool DataNormalizer::AttachMemo(byte aIndex, CompensationMemo* aMemo)
+{
+  if(aIndex >= MAX_NUM_ANALOGUE_INPUTS)
+    return false;
+
+  // A memo taken over from a TableBuilder is used as an ordinary one.
+  if(aMemo)
+  {
+    aMemo->Clear();
+    aMemo->SetReady(true);
+  }
+
+  _Hot[aIndex].Memo = aMemo;
+  return true;
+}
+
+bool DataNormalizer::AttachProfile(byte aIndex, SegmentProfile* aProfile)
+{
+  if(aIndex >= MAX_NUM_ANALOGUE_INPUTS)
+    return false;
+
+  _Hot[aIndex].Profile = aProfile;
+  return true;
+}
+
+int DataNormalizer::NormalizeValue(byte aIndex, int aValue, int* aSegment)
+{
+  int segment;
+  int value = Compensate(aValue, _Hot[aIndex].Calibration, &segment);
+
+  if(aSegment)
+    *aSegment = segment;
+
+  return value;
+}
+
+void DataNormalizer::SaveState(NormalizerState& aState)
+{
+  aState.SensorCount = _SensorCount;
+  aState.ShedPhase   = _ShedPhase;
+
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    aState.Values[i]       = Values[i];
+    aState.Normalized[i]   = Normalized[i];
+    aState.SegmentBases[i] = _Hot[i].SegmentBase;
+  }
+}
+
+bool DataNormalizer::RestoreState(const NormalizerState& aState)
+{
+  if(_StatusCode != S_OK || aState.SensorCount != _SensorCount)
+    return false;
+
+  _ShedPhase = aState.ShedPhase;
+
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    Values[i]        = aState.Values[i];
+    Normalized[i]    = aState.Normalized[i];
+    _Hot[i].SegmentBase = aState.SegmentBases[i];
+  }
+
+  return true;
+}
+
+static void FletcherAdd(unsigned int& aSum1, unsigned int& aSum2, int aValue)
+{
+  aSum1 = (aSum1 + (aValue & 0xFF)) % 255;
+  aSum2 = (aSum2 + aSum1) % 255;
+  aSum1 = (aSum1 + ((aValue >> 8) & 0xFF)) % 255;
+  aSum2 = (aSum2 + aSum1) % 255;
+}
+
+//
+// Fletcher-16 over the configuration, with each value taken as 16 bits so
+// that the result is the same on every target.
+//
+unsigned int DataNormalizer::Fingerprint()
+{
+  if(_StatusCode != S_OK)
+    return 0;
+
+  unsigned int a = 0, b = 0;
+  FletcherAdd(a, b, (_SensorCount << 8) | _VectorSize);
+
+  for(byte i=0; i<_SensorCount; i++)
+  {
+    if(!Present(i))
+    {
+      FletcherAdd(a, b, -1);
+      continue;
+    }
+
+    FletcherAdd(a, b, _Inputs[i]->PinNumber());
+    for(byte j=0; j<_VectorSize; j++)
+      FletcherAdd(a, b, _Hot[i].Calibration[j]);
+  }
+
+  for(byte j=0; j<_VectorSize; j++)
+    FletcherAdd(a, b, _NormalizedVector[j]);
+
+  // Never 0, which means unconfigured.
+  unsigned int result = (b << 8) | a;
+  return result ? result : 1;
+}
+
 bool DataNormalizer::configure(const byte aNumberOfSensors, BaseAnalogRead* aSensorReaders[], 
                                const byte aVectorSize, const int* aCalibrationVectors[], const int aNormalizedVector[])
 {
@@ -96,14 +245,58 @@ bool DataNormalizer::configure(const byte aNumberOfSensors, BaseAnalogRead* aSen
 		_Inputs[i] = aSensorReaders[i];
 	
 	for(int i=0; i<_SensorCount; i++)
-		_CalibrationVectors[i] = aCalibrationVectors[i];
+		_Hot[i].Calibration = aCalibrationVectors[i];
 	
 	_NormalizedVector = aNormalizedVector; 
 	
+	// Remembered results and search orders belong to the old calibration.
+	// Memos part way through a TableBuilder build go back into ordinary use.
+	for(int i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+	{
+		if(_Hot[i].Memo)
+		{
+			_Hot[i].Memo->Clear();
+			_Hot[i].Memo->SetReady(true);
+		}
+		if(_Hot[i].Profile)
+			_Hot[i].Profile->Reset();
+	}
+	
+	_Present = (1 << _SensorCount) - 1;
+	_Enabled = _Present;
+	UpdateActive();
+	
+	_Pipelined = false;
 	_StatusCode = S_OK;
 	return true;
 }
 
+bool DataNormalizer::configure(const byte aNumberOfSensors, AsyncAnalogRead* aSensorReaders[], 
+                               const byte aVectorSize, const int* aCalibrationVectors[], const int aNormalizedVector[])
+{
+	if(aSensorReaders == NULL)
+	{
+		_StatusCode = F_NoSensorList;
+		return false;
+	}
+	
+	if(aNumberOfSensors > MAX_NUM_ANALOGUE_INPUTS)
+	{
+		_StatusCode = F_BadNumberOfSensors;
+		return false;
+	}
+	
+	BaseAnalogRead* readers[MAX_NUM_ANALOGUE_INPUTS];
+	for(int i=0; i<aNumberOfSensors; i++)
+		readers[i] = aSensorReaders[i];
+	
+	if(!configure(aNumberOfSensors, readers, aVectorSize, aCalibrationVectors, aNormalizedVector))
+		return false;
+	
+	_Pipelined = true;
+	return true;
+}
+
 //
 // Finds which segment the raw value lies in.
 //
@@ -114,7 +307,7 @@ bool DataNormalizer::configure(const byte aNumberOfSensors, BaseAnalogRead* aSen
 char DataNormalizer::FindPosition(int aValue, const int* aVector)
 {
   byte i;
-  for(i=0; i<=_VectorSize; i++)
+  for(i=0; i<_VectorSize; i++)
     if(aValue <= aVector[i])
       return i-1;
   
@@ -126,7 +319,7 @@ byte DataNormalizer::IndexOf(byte aPinNumber)
   if(_StatusCode != S_OK) return -1;
 
   for(int i=0; i<_SensorCount; i++)
-    if(_Inputs[i]->PinNumber() == aPinNumber)
+    if(Present(i) && _Inputs[i]->PinNumber() == aPinNumber)
       return i;
 
   return -1;
@@ -137,30 +330,478 @@ bool DataNormalizer::Normalize()
   if (_StatusCode != S_OK) 
     return false;
 
-  for(int i=0; i<_SensorCount; i++)
-    Normalized[i] = Compensate(Values[i], _CalibrationVectors[i], &_SegmentBases[i]);
+  unsigned long start = _Metrics ? micros() : 0;
+  byte skip = ShedMask();
+
+  for(byte k=0; k<_ActiveCount; k++)
+  {
+    byte i = _Active[k];
+    if(!(skip & (1 << i)))
+      Normalized[i] = CompensateSensor(i);
+  }
+
+  if(_Metrics || _Sampler || _Derived)
+    RecordNormalize(_Metrics ? micros() - start : 0, skip);
 
   return true;
 
 }
 
+unsigned int DataNormalizer::NormalizeBatch(DataNormalizer* aInstances[], unsigned int aCount)
+{
+  unsigned int done = 0;
+
+  for(unsigned int k=0; k<aCount; k++)
+    if(aInstances[k] != NULL && aInstances[k]->Normalize())
+      done++;
+
+  return done;
+}
+
+unsigned int DataNormalizer::BlockFrames()
+{
+  if(NORMALIZER_CACHE_BYTES == 0 || _StatusCode != S_OK || _SensorCount == 0)
+    return 0xFFFF;
+
+  // Half the cache for this work, the rest for everything else. The vectors
+  // get what they need, up to half of that; frames in and out get the rest.
+  unsigned long budget = NORMALIZER_CACHE_BYTES / 2;
+  unsigned long tables = (unsigned long)(_SensorCount + 1) * _VectorSize * sizeof(int);
+  if(tables > budget / 2)
+    tables = budget / 2;
+
+  unsigned long frames = (budget - tables) / (2 * _SensorCount * sizeof(int));
+  if(frames > 0xFFFF)
+    frames = 0xFFFF;
+
+  frames &= ~3UL;
+  return frames < 4 ? 4 : frames;
+}
+
+unsigned int DataNormalizer::NormalizeInterleaved(const int aRaw[], unsigned int aFrames, int aOut[], unsigned int aBlockFrames)
+{
+  if(_StatusCode != S_OK || aFrames == 0 || _SensorCount == 0)
+    return 0;
+
+  if(aBlockFrames == 0)
+    aBlockFrames = BlockFrames();
+
+  // Segment bases carry over from block to block, so the blocks give the
+  // same results as one run over the whole buffer.
+  for(unsigned int first=0; first<aFrames; first+=aBlockFrames)
+  {
+    unsigned int frames = aFrames - first < aBlockFrames ? aFrames - first : aBlockFrames;
+    unsigned long offset = (unsigned long)first * _SensorCount;
+
+    for(byte k=0; k<_ActiveCount; k++)
+    {
+      byte i = _Active[k];
+      NormalizeRun(i, aRaw + offset + i, _SensorCount, frames, aOut + offset + i);
+    }
+
+    // Disabled sensors and empty slots repeat their current result.
+    for(byte i=0; i<_SensorCount; i++)
+    {
+      if(_Enabled & (1 << i))
+        continue;
+
+      int* out = aOut + offset + i;
+      for(unsigned int f=0; f<frames; f++, out+=_SensorCount)
+        *out = Normalized[i];
+    }
+
+    if(frames < aBlockFrames)
+      break;
+  }
+
+  return aFrames;
+}
+
+unsigned int DataNormalizer::NormalizePlanar(const int aRaw[], unsigned int aFrames, int aOut[])
+{
+  if(_StatusCode != S_OK || aFrames == 0 || _SensorCount == 0)
+    return 0;
+
+  for(byte k=0; k<_ActiveCount; k++)
+  {
+    byte i = _Active[k];
+    NormalizeRun(i, aRaw + (unsigned int)i * aFrames, 1, aFrames, aOut + (unsigned int)i * aFrames);
+  }
+
+  for(byte i=0; i<_SensorCount; i++)
+  {
+    if(_Enabled & (1 << i))
+      continue;
+
+    int* out = aOut + (unsigned int)i * aFrames;
+    for(unsigned int f=0; f<aFrames; f++)
+      out[f] = Normalized[i];
+  }
+
+  return aFrames;
+}
+
+bool DataNormalizer::UnpackFrame(const byte aPacked[], byte aFormat, unsigned int aFrame)
+{
+  if(_StatusCode != S_OK)
+    return false;
+
+  return PackedSamples::Unpack(aPacked, aFormat, (unsigned long)aFrame * _SensorCount, _SensorCount, Values);
+}
+
+unsigned int DataNormalizer::NormalizePacked(const byte aPacked[], byte aFormat, unsigned int aFrames, int aOut[])
+{
+  if(_StatusCode != S_OK || PackedSamples::Bits(aFormat) == 0)
+    return 0;
+
+  if(aFrames == 0 || _SensorCount == 0)
+    return 0;
+
+  // Disabled sensors keep their Values; NormalizeInterleaved() gives them
+  // their current Normalized entry in aOut.
+  PackedSamples::Unpack(aPacked, aFormat, 0, (unsigned long)aFrames * _SensorCount, aOut);
+  NormalizeInterleaved(aOut, aFrames, aOut);
+  return aFrames;
+}
+
+//
+// Successive readings of one sensor usually fall in the same segment, so the
+// segment of the previous reading is tried before searching. With sorted
+// calibration vectors a reading inside that segment is exactly where the
+// search would have put it.
+//
+void DataNormalizer::NormalizeRun(byte aIndex, const int* aRaw, unsigned int aStride, unsigned int aFrames, int* aOut)
+{
+  SensorState& sensor      = _Hot[aIndex];
+  const int* vector        = sensor.Calibration;
+  const int* normalized    = _NormalizedVector;
+  CompensationMemo* memo   = sensor.Memo && sensor.Memo->Ready() ? sensor.Memo : NULL;
+  SegmentProfile* profile  = sensor.Profile;
+  int base = sensor.SegmentBase;
+  int value = 0;
+  int result = 0;
+
+  for(unsigned int f=0; f<aFrames; f++, aRaw += aStride, aOut += aStride)
+  {
+    value = *aRaw;
+
+    if(memo && memo->Find(value, &result, &base))
+    {
+      *aOut = result;
+      continue;
+    }
+
+    if(base >= 0 && base < _VectorSize - 1 && value > vector[base] && value <= vector[base+1])
+      result = map(value, vector[base], vector[base+1], normalized[base], normalized[base+1]);
+    else
+      result = Compensate(value, vector, &base, profile);
+
+    if(memo)
+      memo->Store(value, result, base);
+
+    *aOut = result;
+  }
+
+  sensor.SegmentBase = base;
+  Values[aIndex]        = value;
+  Normalized[aIndex]    = result;
+}
+
+void DataNormalizer::RecordNormalize(unsigned long aElapsed, byte aSkip)
+{
+  if(_Derived)
+    _Derived->Evaluate(Normalized);
+
+  if(_Sampler)
+    _Sampler->Update(Normalized, _SensorCount, ~aSkip);
+
+  if(!_Metrics)
+    return;
+
+  _Metrics->BeginUpdate();
+  _Metrics->Frames++;
+  _Metrics->NormalizeMicros = aElapsed;
+  _Metrics->TotalNormalizeMicros += aElapsed;
+  for(byte k=0; k<_ActiveCount; k++)
+  {
+    byte i = _Active[k];
+    if(aSkip & (1 << i))
+      continue;
+
+    if(_Hot[i].SegmentBase == SEGMENT_INDEX_LOW)
+      _Metrics->SaturatedLow[i]++;
+    else if(_Hot[i].SegmentBase == SEGMENT_INDEX_HIGH)
+      _Metrics->SaturatedHigh[i]++;
+  }
+  _Metrics->EndUpdate();
+}
+
 bool DataNormalizer::Read()
 {
   if (_StatusCode != S_OK) 
     return false;
 
-  for(int i=0; i<_SensorCount; i++)
-    Values[i] = _Inputs[i]->Read();
+  unsigned long start = _Metrics ? micros() : 0;
+
+  byte due = DueMask();
+
+  if(_Planner)
+    _Planner->Scan(_Inputs, Values, _SensorCount, due);
+  else
+    for(byte k=0; k<_ActiveCount; k++)
+    {
+      byte i = _Active[k];
+      if(due & (1 << i))
+        Values[i] = _Inputs[i]->Read();
+    }
+
+  if(_Metrics)
+  {
+    unsigned long elapsed = micros() - start;
+
+    _Metrics->BeginUpdate();
+    _Metrics->ReadMicros = elapsed;
+    _Metrics->TotalReadMicros += elapsed;
+    _Metrics->EndUpdate();
+  }
+
+  return true;
+}
+
+bool DataNormalizer::SetCalibration(byte aIndex, const int aCalibrationVector[])
+{
+  if(_StatusCode != S_OK || !Present(aIndex) || aCalibrationVector == NULL)
+    return false;
+
+  _Hot[aIndex].Calibration = aCalibrationVector;
+  _Hot[aIndex].SegmentBase = SEGMENT_INDEX_LOW;
+
+  // Only this sensor's remembered results, search order and sampling
+  // rate are stale.
+  if(_Hot[aIndex].Memo)
+    _Hot[aIndex].Memo->Clear();
+  if(_Hot[aIndex].Profile)
+    _Hot[aIndex].Profile->Reset();
+  if(_Sampler)
+    _Sampler->Reset(aIndex);
+
+  return true;
+}
+
+bool DataNormalizer::SetReader(byte aIndex, BaseAnalogRead* aReader)
+{
+  // A pipelined normalizer needs readers that convert in the background.
+  if(_StatusCode != S_OK || !Present(aIndex) || aReader == NULL || _Pipelined)
+    return false;
+
+  _Inputs[aIndex] = aReader;
+
+  // How quiet the old reader was says nothing about the new one.
+  if(_Sampler)
+    _Sampler->Reset(aIndex);
+
+  return true;
+}
+
+bool DataNormalizer::SetReader(byte aIndex, AsyncAnalogRead* aReader)
+{
+  if(_StatusCode != S_OK || !Present(aIndex) || aReader == NULL)
+    return false;
+
+  _Inputs[aIndex] = aReader;
+
+  // How quiet the old reader was says nothing about the new one.
+  if(_Sampler)
+    _Sampler->Reset(aIndex);
 
   return true;
 }
 
+bool DataNormalizer::Enable(byte aIndex, bool aEnabled)
+{
+  if(_StatusCode != S_OK || !Present(aIndex))
+    return false;
+
+  if(aEnabled)
+    _Enabled |= 1 << aIndex;
+  else
+    _Enabled &= ~(1 << aIndex);
+
+  UpdateActive();
+  return true;
+}
+
+void DataNormalizer::UpdateActive()
+{
+  _ActiveCount = 0;
+
+  for(byte i=0; i<_SensorCount; i++)
+    if(_Enabled & (1 << i))
+      _Active[_ActiveCount++] = i;
+}
+
+byte DataNormalizer::AddSensor(BaseAnalogRead* aReader, const int aCalibrationVector[])
+{
+  if(_Pipelined)
+    return -1;
+
+  return PlaceSensor(aReader, aCalibrationVector);
+}
+
+byte DataNormalizer::AddSensor(AsyncAnalogRead* aReader, const int aCalibrationVector[])
+{
+  return PlaceSensor(aReader, aCalibrationVector);
+}
+
+byte DataNormalizer::PlaceSensor(BaseAnalogRead* aReader, const int aCalibrationVector[])
+{
+  if(_StatusCode != S_OK || aReader == NULL || aCalibrationVector == NULL)
+    return -1;
+
+  byte id = 0;
+  while(id < MAX_NUM_ANALOGUE_INPUTS && Present(id))
+    id++;
+
+  if(id == MAX_NUM_ANALOGUE_INPUTS)
+    return -1;
+
+  _Inputs[id]             = aReader;
+  _Hot[id].Calibration    = aCalibrationVector;
+  _Hot[id].SegmentBase    = SEGMENT_INDEX_LOW;
+  Values[id]              = 0;
+  Normalized[id]          = 0;
+
+  if(_Hot[id].Memo)
+  {
+    _Hot[id].Memo->Clear();
+    _Hot[id].Memo->SetReady(true);
+  }
+  if(_Hot[id].Profile)
+    _Hot[id].Profile->Reset();
+  if(_Sampler)
+    _Sampler->Reset(id);
+
+  _Present |= 1 << id;
+  _Enabled |= 1 << id;
+  if(id >= _SensorCount)
+    _SensorCount = id + 1;
+
+  UpdateActive();
+  return id;
+}
+
+bool DataNormalizer::RemoveSensor(byte aIndex)
+{
+  if(_StatusCode != S_OK || !Present(aIndex))
+    return false;
+
+  _Present &= ~(1 << aIndex);
+  _Enabled &= ~(1 << aIndex);
+  _Inputs[aIndex] = NULL;
+
+  // Trailing empty slots are dropped; others stay as holes so that the
+  // remaining IDs do not move.
+  while(_SensorCount > 0 && !Present(_SensorCount - 1))
+    _SensorCount--;
+
+  UpdateActive();
+  return true;
+}
+
+bool DataNormalizer::ReadSensor(byte aIndex)
+{
+  if(_StatusCode != S_OK || !Present(aIndex))
+    return false;
+
+  Values[aIndex] = _Inputs[aIndex]->Read();
+  return true;
+}
+
+bool DataNormalizer::NormalizeSensor(byte aIndex)
+{
+  if(_StatusCode != S_OK || !Present(aIndex))
+    return false;
+
+  Normalized[aIndex] = CompensateSensor(aIndex);
+  return true;
+}
+
 bool DataNormalizer::ReadAndNormalize()
 {
-  if(!Read())
+  if(!_Pipelined)
+  {
+    if(!Read())
+      return false;
+
+    return Normalize();
+  }
+
+  if (_StatusCode != S_OK) 
     return false;
 
-  return Normalize();
+  unsigned long start = _Metrics ? micros() : 0;
+  byte due = DueMask();
+  byte skip = ShedMask();
+
+  // Find the first sensor to convert, by its place in _Active.
+  byte next = 0;
+  while(next < _ActiveCount && !(due & (1 << _Active[next])))
+    next++;
+
+  if(next < _ActiveCount)
+    static_cast<AsyncAnalogRead*>(_Inputs[_Active[next]])->StartConversion();
+
+  for(byte k=0; k<_ActiveCount; k++)
+  {
+    byte i = _Active[k];
+
+    if(k == next)
+    {
+      Values[i] = static_cast<AsyncAnalogRead*>(_Inputs[i])->FinishConversion();
+
+      // Start the following conversion before normalizing this one.
+      next++;
+      while(next < _ActiveCount && !(due & (1 << _Active[next])))
+        next++;
+
+      if(next < _ActiveCount)
+        static_cast<AsyncAnalogRead*>(_Inputs[_Active[next]])->StartConversion();
+    }
+
+    if(!(skip & (1 << i)))
+      Normalized[i] = CompensateSensor(i);
+  }
+
+  if(_Metrics)
+  {
+    unsigned long elapsed = micros() - start;
+
+    _Metrics->BeginUpdate();
+    _Metrics->ReadMicros = elapsed;
+    _Metrics->TotalReadMicros += elapsed;
+    _Metrics->EndUpdate();
+  }
+
+  if(_Metrics || _Sampler || _Derived)
+    RecordNormalize(0, skip);
+
+  return true;
+}
+
+byte DataNormalizer::ShedMask()
+{
+  if(_Overload == NULL)
+    return ~_Enabled;
+
+  return _Overload->SkipMask(_Sheddable & _Enabled, _ShedPhase++) | ~_Enabled;
+}
+
+byte DataNormalizer::DueMask()
+{
+  if(_Sampler)
+    return _Sampler->Due(_SensorCount, _Enabled);
+
+  return _Enabled;
 }
 
 
@@ -21,6 +21,15 @@
 #include "Arduino.h"
 #include <BaseAnalogRead.h>
 
+class AdaptiveSampler;
+class AsyncAnalogRead;
+class CompensationMemo;
+class DerivedChannels;
+class NormalizerMetrics;
+class OverloadController;
+class ScanPlanner;
+class SegmentProfile;
+
 //
 // SUMMARY
 //
@@ -91,6 +100,30 @@ const int SEGMENT_INDEX_HIGH        = -2;
 // The maximum number of analogue inputs on the Adruino Uno.
 const int MAX_NUM_ANALOGUE_INPUTS   =  6;
 
+// The level 1 data cache, in bytes, that NormalizeInterleaved() sizes its
+// blocks of frames for. AVR parts have no cache, so 0 there means the whole
+// buffer is one block. Define it before including this file to suit a host.
+#ifndef NORMALIZER_CACHE_BYTES
+#ifdef __AVR__
+#define NORMALIZER_CACHE_BYTES 0
+#else
+#define NORMALIZER_CACHE_BYTES 32768
+#endif
+#endif
+
+//
+// The part of a normalizer that carries over from one frame to the next,
+// as saved by SaveState(). Configuration is not included.
+//
+struct NormalizerState
+{
+  byte SensorCount;
+  byte ShedPhase;
+  int Values[MAX_NUM_ANALOGUE_INPUTS];
+  int Normalized[MAX_NUM_ANALOGUE_INPUTS];
+  int SegmentBases[MAX_NUM_ANALOGUE_INPUTS];
+};
+
 class DataNormalizer 
 {
   public:
@@ -110,7 +143,7 @@ class DataNormalizer
     };
 
   public:
-    DataNormalizer() : _StatusCode(F_Uninitialized) {}
+    DataNormalizer();
 
     //
     // aNumberOfSensors    - the number of sensors this object will track
@@ -129,6 +162,16 @@ class DataNormalizer
     bool configure(const byte aNumberOfSensors, BaseAnalogRead* aSensorReaders[], 
                    const byte aVectorSize, const int* aCalibrationVectors[], const int aNormalizedVector[]);
 
+    //
+    // As above, but with readers that can convert in the background.
+    //
+    // ReadAndNormalize() then works in a pipeline: while the ADC converts 
+    // sensor i+1, sensor i is normalized. A frame takes about as long as its
+    // conversions rather than the conversions plus the normalization.
+    //
+    bool configure(const byte aNumberOfSensors, AsyncAnalogRead* aSensorReaders[], 
+                   const byte aVectorSize, const int* aCalibrationVectors[], const int aNormalizedVector[]);
+
     //
     // Contains the latest readings from the sensors. 
     //
@@ -165,6 +208,69 @@ class DataNormalizer
     //
     bool Normalize();
 
+    //
+    // Performs Normalize() on each of aCount objects, which may have different
+    // sensor counts and vector sizes. NULL and unconfigured objects are skipped.
+    //
+    // Returns the number of objects normalized.
+    //
+    static unsigned int NormalizeBatch(DataNormalizer* aInstances[], unsigned int aCount);
+
+    //
+    // Normalizes a buffer of aFrames captured frames into aOut, one sensor at
+    // a time. Each reading gives the same result as Normalize() would.
+    //
+    // NormalizeInterleaved() takes frames laid out as Values is, sensor 0 to
+    // SensorCount()-1 then the next frame; NormalizePlanar() takes all the
+    // readings of sensor 0, then all of sensor 1, and so on. aOut has the same
+    // layout as aRaw. See FrameTranspose for converting between the two.
+    //
+    // NormalizeInterleaved() works through the buffer in blocks of
+    // aBlockFrames frames, all sensors over one block before the next, so
+    // that the block and the calibration vectors stay in cache together.
+    // 0 picks the block size with BlockFrames().
+    //
+    // Disabled sensors and empty slots are not normalized: their entries in
+    // aOut get their current Normalized entry in every frame.
+    //
+    // Afterwards Values and Normalized hold the last frame. Load shedding,
+    // samplers, derived channels and metrics are not consulted.
+    //
+    // Returns the number of frames normalized, or 0 if unconfigured or
+    // there are no sensors.
+    //
+    unsigned int NormalizeInterleaved(const int aRaw[], unsigned int aFrames, int aOut[], unsigned int aBlockFrames = 0);
+    unsigned int NormalizePlanar(const int aRaw[], unsigned int aFrames, int aOut[]);
+
+    //
+    // The number of frames per block NormalizeInterleaved() uses by default:
+    // as many as fit in half of NORMALIZER_CACHE_BYTES beside the calibration
+    // vectors, in multiples of 4, or every frame when there is no cache or
+    // no sensor.
+    //
+    unsigned int BlockFrames();
+
+    //
+    // Unpacks frame aFrame of a packed sample stream straight into Values.
+    // aFormat is one of the PackedFormats, and each frame holds SensorCount()
+    // samples.
+    //
+    // Returns false if unconfigured or aFormat is unknown.
+    //
+    bool UnpackFrame(const byte aPacked[], byte aFormat, unsigned int aFrame);
+
+    //
+    // Unpacks aFrames frames of a packed stream into aOut and normalizes
+    // them there in place, as NormalizeInterleaved() would, with
+    // interleaved results in aOut. The whole stream is unpacked in one
+    // pass, so there is no intermediate buffer. Disabled sensors get their
+    // current Normalized entry in every frame.
+    //
+    // Returns the number of frames normalized, or 0 if unconfigured, there
+    // are no sensors, or aFormat is unknown.
+    //
+    unsigned int NormalizePacked(const byte aPacked[], byte aFormat, unsigned int aFrames, int aOut[]);
+
     //
     // Populate the Values array with values from the analog pins.
     //
@@ -172,28 +278,236 @@ class DataNormalizer
     //
     bool Read();
 
+    //
+    // Read() and Normalize() for the single sensor aIndex. Samplers, planners
+    // and load shedding are not consulted.
+    //
+    // Returns false if unconfigured or there is no such sensor.
+    //
+    bool ReadSensor(byte aIndex);
+    bool NormalizeSensor(byte aIndex);
+
     //
     // As advertized; calls Read() and Normalize() if there are no errors.
     //
+    // If the object was configured with AsyncAnalogRead readers, the two
+    // are overlapped as described above. Metrics then record the whole
+    // frame as read time.
+    //
     // Returns a boolean indicating success.
     //
     bool ReadAndNormalize();
 
+    //
+    // Changes one sensor of a configured object without configure().
+    // SetCalibration() resets only that sensor's memo, profile, segment and
+    // sampler state; SetReader() only its sampler state.
+    //
+    // SetReader() with a BaseAnalogRead fails on an object configured with
+    // AsyncAnalogRead readers, since ReadAndNormalize() relies on them.
+    //
+    // Returns false if unconfigured, there is no such sensor, or the new
+    // vector or reader is NULL.
+    //
+    bool SetCalibration(byte aIndex, const int aCalibrationVector[]);
+    bool SetReader(byte aIndex, BaseAnalogRead* aReader);
+    bool SetReader(byte aIndex, AsyncAnalogRead* aReader);
+
+    //
+    // A disabled sensor is neither read nor normalized, and keeps its last
+    // Values and Normalized entries. configure() enables every sensor.
+    //
+    // Returns false if unconfigured or there is no such sensor.
+    //
+    bool Enable(byte aIndex, bool aEnabled = true);
+    bool Disable(byte aIndex) { return Enable(aIndex, false); }
+    bool Enabled(byte aIndex) { return _Enabled & (1 << aIndex); }
+
+    //
+    // Adds a sensor at run time, in the lowest free slot, and enables it.
+    // The slot number is its ID: its index in Values and Normalized, and
+    // for every per-sensor call. IDs do not change when other sensors are
+    // added or removed. Whatever the slot's memo, profile and sampler
+    // learned from a previous occupant is forgotten.
+    //
+    // The object must be configured first, if need be with no sensors; the
+    // new sensor shares its vector size and normalized vector. A BaseAnalogRead
+    // cannot be added to an object configured with AsyncAnalogRead readers.
+    //
+    // Returns the ID, or -1 if unconfigured, full or given NULL.
+    //
+    byte AddSensor(BaseAnalogRead* aReader, const int aCalibrationVector[]);
+    byte AddSensor(AsyncAnalogRead* aReader, const int aCalibrationVector[]);
+
+    //
+    // Removes sensor aIndex. Its slot becomes free for AddSensor(), and its
+    // Values and Normalized entries are left as they were.
+    //
+    // SensorCount() is one more than the highest ID in use, so it can
+    // include empty slots; Input() returns NULL for them. The loops of
+    // Read() and Normalize() visit only the enabled sensors.
+    //
+    // Returns false if unconfigured or there is no such sensor.
+    //
+    bool RemoveSensor(byte aIndex);
+
+    // True if slot aIndex holds a sensor.
+    bool Present(byte aIndex) { return aIndex < MAX_NUM_ANALOGUE_INPUTS && (_Present & (1 << aIndex)); }
+
+    // True if configured with AsyncAnalogRead readers.
+    bool Pipelined() { return _Pipelined; }
+
     byte SensorCount() { return _SensorCount; }
 
+    // The reader of sensor aIndex, or NULL if there is no such sensor.
+    BaseAnalogRead* Input(byte aIndex) { return aIndex < _SensorCount ? _Inputs[aIndex] : NULL; }
+
+    //
+    // Publishes frame counts, timings and saturation counts into aMetrics
+    // on every Read() and Normalize(). Pass NULL to stop. 
+    //
+    // Nothing is measured while no metrics block is attached.
+    //
+    void AttachMetrics(NormalizerMetrics* aMetrics) { _Metrics = aMetrics; }
+
+    //
+    // Lets aPlanner choose the order of conversions in Read(), and where 
+    // throwaway conversions are needed. Pass NULL to read in index order.
+    //
+    void AttachScanPlanner(ScanPlanner* aPlanner) { _Planner = aPlanner; }
+
+    //
+    // Lets aSampler skip the conversion of sensors whose readings have been
+    // steady, in Read() and ReadAndNormalize(). Skipped sensors keep their
+    // previous values. Pass NULL to convert every sensor on every frame.
+    //
+    void AttachSampler(AdaptiveSampler* aSampler) { _Sampler = aSampler; }
+
+    //
+    // Lets aMemo remember the normalized value of each reading of sensor
+    // aIndex, so that repeated readings skip the segment search and the
+    // interpolation. Pass NULL to stop.
+    //
+    // Returns false if there is no such sensor.
+    //
+    bool AttachMemo(byte aIndex, CompensationMemo* aMemo);
+
+    // The memo attached to sensor aIndex, or NULL.
+    CompensationMemo* Memo(byte aIndex) { return aIndex < MAX_NUM_ANALOGUE_INPUTS ? _Hot[aIndex].Memo : NULL; }
+
+    //
+    // The normalized value of reading aValue of sensor aIndex, and its
+    // segment in *aSegment unless NULL. Nothing is remembered or counted,
+    // and neither memos nor profiles are consulted.
+    //
+    // aIndex must be a configured sensor.
+    //
+    int NormalizeValue(byte aIndex, int aValue, int* aSegment = NULL);
+
+    //
+    // Lets aProfile order the segment search of sensor aIndex by how often
+    // each segment is hit. Results are unchanged. Pass NULL to stop.
+    //
+    // Returns false if there is no such sensor.
+    //
+    bool AttachProfile(byte aIndex, SegmentProfile* aProfile);
+
+    //
+    // Lets aOverload skip the normalization of the sensors in aSheddable
+    // (bit i for sensor i) on some frames while a backlog is too long. 
+    // Skipped sensors keep their previous Normalized values. Pass NULL to 
+    // always normalize every sensor.
+    //
+    void AttachOverload(OverloadController* aOverload, byte aSheddable) { _Overload = aOverload; _Sheddable = aSheddable; }
+
+    //
+    // Lets aDerived compute its channels from Normalized at the end of every
+    // Normalize(), ReadAndNormalize() and NormalizeBatch(). Pass NULL to stop.
+    //
+    void AttachDerived(DerivedChannels* aDerived) { _Derived = aDerived; }
+
+    //
+    // Copies the frame-to-frame state into aState, or restores it. Together
+    // with the same configuration and attachments, a restored normalizer
+    // continues exactly as the saved one would have.
+    //
+    // RestoreState() returns false if unconfigured or the sensor count
+    // differs.
+    //
+    void SaveState(NormalizerState& aState);
+    bool RestoreState(const NormalizerState& aState);
+
+    //
+    // A 16-bit hash of the configuration: the sensor count, pin numbers,
+    // vector size and the contents of every vector. Saved state is only
+    // meaningful to a normalizer with the same fingerprint.
+    //
+    // Returns 0 if unconfigured.
+    //
+    unsigned int Fingerprint();
+
     // Return the status of the object per the status codes above.
     ErrorCodes StatusCode() { return _StatusCode; }
 
   private:
     // Perform compensation.
-    int Compensate(int aValue, const int* aVector, int* aIndex);
+    int Compensate(int aValue, const int* aVector, int* aIndex, SegmentProfile* aProfile = NULL);
+
+    // Perform compensation for sensor aIndex, consulting its memo if any.
+    int CompensateSensor(byte aIndex);
+
+    // Normalize aFrames readings of sensor aIndex, aStride elements apart.
+    void NormalizeRun(byte aIndex, const int* aRaw, unsigned int aStride, unsigned int aFrames, int* aOut);
+
+    // Publish the results of a Normalize() to _Derived, _Sampler and _Metrics.
+    // aSkip holds the sensors that were not normalized, as from ShedMask().
+    void RecordNormalize(unsigned long aElapsed, byte aSkip);
+
+    // Rebuild _Active from _Enabled.
+    void UpdateActive();
+
+    // Put a sensor in the lowest free slot; see AddSensor().
+    byte PlaceSensor(BaseAnalogRead* aReader, const int aCalibrationVector[]);
+
+    // The sensors to convert in this frame, one bit per sensor.
+    byte DueMask();
+
+    // The sensors not to normalize in this frame, one bit per sensor.
+    byte ShedMask();
 
     // Find the correct segment to use for interpolation.
     char FindPosition(int aValue, const int* aVector);
 
-    BaseAnalogRead* _Inputs[MAX_NUM_ANALOGUE_INPUTS];
+    //
+    // Hot state: what Normalize() touches for every sensor on every frame,
+    // kept together in one entry per sensor rather than spread over several
+    // separate arrays.
+    //
+    struct SensorState
+    {
+      // The sensor's calibration row vector.
+      const int* Calibration;
 
-    // This is the number of sensors.
+      // Optional remembered results and segment search order.
+      CompensationMemo* Memo;
+      SegmentProfile* Profile;
+
+      // The lower index of the segment the latest reading fell in.
+      // SEGMENT_INDEX_LOW means that the reading fell below the lowest segment range.
+      // SEGMENT_INDEX_HIGH means that the reading fell above the highest segment range.
+      int SegmentBase;
+    };
+
+    SensorState _Hot[MAX_NUM_ANALOGUE_INPUTS];
+
+    // The enabled sensors in ID order, so the frame loops skip the rest.
+    byte _Active[MAX_NUM_ANALOGUE_INPUTS];
+    byte _ActiveCount;
+
+    // Sensors that are read and normalized, one bit per slot.
+    byte _Enabled;
+
+    // This is the number of sensor slots.
     byte _SensorCount;
     
     // This is the number of elements in the calibration vectors.
@@ -202,16 +516,38 @@ class DataNormalizer
     // This is the vector of normalized values.
     const int* _NormalizedVector;
 
-    // This is the array that contains _SensorCount calibration row vectors.
-    const int* _CalibrationVectors[MAX_NUM_ANALOGUE_INPUTS];
-
     // Last error code.
     ErrorCodes _StatusCode;
 
-    // Contains the lower index of the segment that the readings falls in.
-    // SEGMENT_INDEX_LOW means that the reading falls below the lowest segment range.
-    // SEGMENT_INDEX_HIGH means that the reading falls above the highest segment range.
-    int _SegmentBases[MAX_NUM_ANALOGUE_INPUTS];
+    //
+    // Cold state: configuration and attachments, not touched by Normalize().
+    // Read() uses _Inputs once per sensor.
+    //
+    BaseAnalogRead* _Inputs[MAX_NUM_ANALOGUE_INPUTS];
+
+    // Slots holding a sensor, one bit per slot.
+    byte _Present;
+
+    // True if every element of _Inputs is an AsyncAnalogRead.
+    bool _Pipelined;
+
+    // Optional counters for an external observer.
+    NormalizerMetrics* _Metrics;
+
+    // Optional conversion order for Read().
+    ScanPlanner* _Planner;
+
+    // Optional choice of which sensors Read() converts.
+    AdaptiveSampler* _Sampler;
+
+    // Optional load shedding, the sensors it may skip, and a frame counter
+    // that spreads the skipping evenly.
+    OverloadController* _Overload;
+    byte _Sheddable;
+    byte _ShedPhase;
+
+    // Optional channels computed from the normalized readings.
+    DerivedChannels* _Derived;
 
 };
 
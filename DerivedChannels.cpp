@@ -0,0 +1,226 @@
+/*
+ *  DerivedChannels.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "DerivedChannels.h"
+
+// The limits at which the evaluator's arithmetic saturates.
+static const int32_t DERIVED_MAX = 0x7FFFFFFF;
+static const int32_t DERIVED_MIN = -DERIVED_MAX - 1;
+
+//
+// The arithmetic of the evaluator, saturating at 32 bits. Signed overflow
+// is undefined in C++, so it is detected by the compiler's checked
+// builtins rather than after the fact.
+//
+static int32_t SaturatingAdd(int32_t a, int32_t b)
+{
+  int32_t result;
+  if(__builtin_add_overflow(a, b, &result))
+    return b > 0 ? DERIVED_MAX : DERIVED_MIN;
+  return result;
+}
+
+static int32_t SaturatingSub(int32_t a, int32_t b)
+{
+  int32_t result;
+  if(__builtin_sub_overflow(a, b, &result))
+    return b < 0 ? DERIVED_MAX : DERIVED_MIN;
+  return result;
+}
+
+static int32_t SaturatingMul(int32_t a, int32_t b)
+{
+  int32_t result;
+  if(__builtin_mul_overflow(a, b, &result))
+    return (a < 0) != (b < 0) ? DERIVED_MIN : DERIVED_MAX;
+  return result;
+}
+
+static int32_t SaturatingNeg(int32_t a)
+{
+  return a == DERIVED_MIN ? DERIVED_MAX : -a;
+}
+
+//
+// Walks the program once, tracking the stack depth, without evaluating it.
+//
+bool DerivedChannels::configure(const byte aProgram[], unsigned int aLength, int aOutputs[], byte aOutputCount)
+{
+  if(aProgram == NULL || (aOutputs == NULL && aOutputCount > 0))
+    return false;
+
+  byte depth = 0;
+  unsigned int pc = 0;
+
+  while(pc < aLength)
+  {
+    byte op = aProgram[pc++];
+    byte pops, pushes, operands;
+
+    switch(op)
+    {
+      case DC_OP_END:
+        if(depth != 0)
+          return false;
+
+        _Program     = aProgram;
+        _Outputs     = aOutputs;
+        _OutputCount = aOutputCount;
+
+        for(byte i=0; i<_OutputCount; i++)
+          _Outputs[i] = 0;
+
+        return true;
+
+      case DC_OP_CHANNEL: pops = 0; pushes = 1; operands = 1; break;
+      case DC_OP_CONST:   pops = 0; pushes = 1; operands = 2; break;
+      case DC_OP_OUTPUT:  pops = 0; pushes = 1; operands = 1; break;
+      case DC_OP_STORE:   pops = 1; pushes = 0; operands = 1; break;
+      case DC_OP_SHR:     pops = 1; pushes = 1; operands = 1; break;
+      case DC_OP_ABS:
+      case DC_OP_NEG:     pops = 1; pushes = 1; operands = 0; break;
+      case DC_OP_CLAMP:   pops = 3; pushes = 1; operands = 0; break;
+      case DC_OP_ADD:
+      case DC_OP_SUB:
+      case DC_OP_MUL:
+      case DC_OP_DIV:
+      case DC_OP_MIN:
+      case DC_OP_MAX:     pops = 2; pushes = 1; operands = 0; break;
+      default:
+        return false;
+    }
+
+    if(pc + operands > aLength)
+      return false;
+
+    if(operands == 1)
+    {
+      byte n = aProgram[pc];
+      if((op == DC_OP_CHANNEL && n >= MAX_NUM_ANALOGUE_INPUTS)
+         || ((op == DC_OP_OUTPUT || op == DC_OP_STORE) && n >= aOutputCount)
+         || (op == DC_OP_SHR && n > 31))
+        return false;
+    }
+
+    if(depth < pops)
+      return false;
+
+    depth = depth - pops + pushes;
+    if(depth > DERIVED_STACK_DEPTH)
+      return false;
+
+    pc += operands;
+  }
+
+  // Ran off the end without DC_END.
+  return false;
+}
+
+void DerivedChannels::Evaluate(const int aNormalized[])
+{
+  if(_Program == NULL)
+    return;
+
+  int32_t stack[DERIVED_STACK_DEPTH];
+  byte sp = 0;
+  const byte* pc = _Program;
+
+  for(;;)
+  {
+    switch(*pc++)
+    {
+      case DC_OP_END:
+        return;
+
+      case DC_OP_CHANNEL:
+        stack[sp++] = aNormalized[*pc++];
+        break;
+
+      case DC_OP_CONST:
+      {
+        // Sign-extend by hand; int is wider than 16 bits off AVR.
+        int32_t value = pc[0] | ((uint16_t)pc[1] << 8);
+        stack[sp++] = value > 32767 ? value - 65536L : value;
+        pc += 2;
+        break;
+      }
+
+      case DC_OP_OUTPUT:
+        stack[sp++] = _Outputs[*pc++];
+        break;
+
+      case DC_OP_STORE:
+      {
+        int32_t value = stack[--sp];
+        if(value > 32767)
+          value = 32767;
+        else if(value < -32768)
+          value = -32768;
+        _Outputs[*pc++] = value;
+        break;
+      }
+
+      case DC_OP_ADD: sp--; stack[sp-1] = SaturatingAdd(stack[sp-1], stack[sp]); break;
+      case DC_OP_SUB: sp--; stack[sp-1] = SaturatingSub(stack[sp-1], stack[sp]); break;
+      case DC_OP_MUL: sp--; stack[sp-1] = SaturatingMul(stack[sp-1], stack[sp]); break;
+
+      case DC_OP_DIV:
+        sp--;
+        if(stack[sp] == 0)
+          stack[sp-1] = 0;
+        else if(stack[sp] == -1)
+          stack[sp-1] = SaturatingNeg(stack[sp-1]);
+        else
+          stack[sp-1] /= stack[sp];
+        break;
+
+      case DC_OP_SHR:
+        stack[sp-1] >>= *pc++;
+        break;
+
+      case DC_OP_MIN:
+        sp--;
+        if(stack[sp] < stack[sp-1])
+          stack[sp-1] = stack[sp];
+        break;
+
+      case DC_OP_MAX:
+        sp--;
+        if(stack[sp] > stack[sp-1])
+          stack[sp-1] = stack[sp];
+        break;
+
+      case DC_OP_ABS:
+        if(stack[sp-1] < 0)
+          stack[sp-1] = SaturatingNeg(stack[sp-1]);
+        break;
+
+      case DC_OP_NEG:
+        stack[sp-1] = SaturatingNeg(stack[sp-1]);
+        break;
+
+      case DC_OP_CLAMP:
+        sp -= 2;
+        if(stack[sp-1] < stack[sp])
+          stack[sp-1] = stack[sp];
+        else if(stack[sp-1] > stack[sp+1])
+          stack[sp-1] = stack[sp+1];
+        break;
+    }
+  }
+}
+
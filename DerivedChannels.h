@@ -0,0 +1,141 @@
+//
+//  DerivedChannels.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef DERIVED_CHANNELS_H
+#define DERIVED_CHANNELS_H
+
+#include <stdint.h>
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+//
+// The instructions of a derived-channel program. Operands follow the
+// operation byte; the DC_ macros below write them out.
+//
+enum DerivedOps
+{
+  DC_OP_END,        // End of program.
+  DC_OP_CHANNEL,    // n     : push Normalized[n].
+  DC_OP_CONST,      // lo hi : push a 16-bit constant.
+  DC_OP_OUTPUT,     // n     : push a derived channel computed earlier.
+  DC_OP_STORE,      // n     : pop into derived channel n.
+  DC_OP_ADD,        // a b -> a+b
+  DC_OP_SUB,        // a b -> a-b
+  DC_OP_MUL,        // a b -> a*b
+  DC_OP_DIV,        // a b -> a/b, or 0 if b is 0
+  DC_OP_SHR,        // n     : a -> a >> n, for fixed-point scaling
+  DC_OP_MIN,        // a b -> the smaller
+  DC_OP_MAX,        // a b -> the larger
+  DC_OP_ABS,        // a -> |a|
+  DC_OP_NEG,        // a -> -a
+  DC_OP_CLAMP       // a lo hi -> a limited to lo..hi
+};
+
+#define DC_END              DC_OP_END
+#define DC_CHANNEL(n)       DC_OP_CHANNEL, (n)
+#define DC_CONST(k)         DC_OP_CONST, (byte)((k) & 0xFF), (byte)(((k) >> 8) & 0xFF)
+#define DC_OUTPUT(n)        DC_OP_OUTPUT, (n)
+#define DC_STORE(n)         DC_OP_STORE, (n)
+#define DC_ADD              DC_OP_ADD
+#define DC_SUB              DC_OP_SUB
+#define DC_MUL              DC_OP_MUL
+#define DC_DIV              DC_OP_DIV
+#define DC_SHR(n)           DC_OP_SHR, (n)
+#define DC_MIN              DC_OP_MIN
+#define DC_MAX              DC_OP_MAX
+#define DC_ABS              DC_OP_ABS
+#define DC_NEG              DC_OP_NEG
+#define DC_CLAMP            DC_OP_CLAMP
+
+// The deepest evaluation stack a program may need.
+const byte DERIVED_STACK_DEPTH = 8;
+
+//
+// SUMMARY
+//
+// Computes user-defined quantities from the normalized readings as part of
+// every Normalize().
+//
+// PURPOSE
+//
+// Weighted sums, clamped differences and ratios of the normalized readings
+// are otherwise recomputed by hand after each frame. Here they are written
+// once, as a short program, and evaluated by the normalizer itself.
+//
+// USE
+//
+// A program is a byte array in reverse Polish order, ending with DC_END.
+// Arithmetic is done in 32 bits on every target. A result that does not
+// fit saturates at the 32-bit limit rather than wrapping, so a formula
+// gives the same answer on the AVR as on a host, and a long chain of
+// multiplications ends pinned at the limit instead of at a wrong value.
+// Stored results are limited to the range of a 16-bit int. Fractions are
+// written in fixed point: multiply, then shift.
+//
+// The program is checked once by configure(): every operand must be in
+// range and the stack must neither underflow nor exceed its depth. After
+// that, evaluation does no checking and allocates nothing.
+//
+// EXAMPLE
+//
+// The mean of sensors 0 and 1, and 3/4 of the difference between sensors
+// 2 and 3 limited to +-50:
+//
+// const byte Program[] = {
+//   DC_CHANNEL(0), DC_CHANNEL(1), DC_ADD, DC_SHR(1), DC_STORE(0),
+//   DC_CHANNEL(2), DC_CHANNEL(3), DC_SUB, DC_CONST(3), DC_MUL, DC_SHR(2),
+//   DC_CONST(-50), DC_CONST(50), DC_CLAMP, DC_STORE(1),
+//   DC_END
+// };
+// int Derived[2];
+// DerivedChannels Formulas;
+//
+// Formulas.configure(Program, sizeof(Program), Derived, 2);
+// Sensors.AttachDerived(&Formulas);
+//
+class DerivedChannels
+{
+  public:
+    DerivedChannels() : _Program(NULL), _Outputs(NULL), _OutputCount(0) {}
+
+    //
+    // aProgram     - the program, ending with DC_END.
+    // aLength      - the number of bytes in aProgram.
+    // aOutputs     - where the derived channels are stored.
+    // aOutputCount - the number of elements in aOutputs.
+    //
+    // Returns false if the program is malformed.
+    //
+    bool configure(const byte aProgram[], unsigned int aLength, int aOutputs[], byte aOutputCount);
+
+    //
+    // Runs the program over aNormalized. Called by DataNormalizer::Normalize().
+    //
+    void Evaluate(const int aNormalized[]);
+
+    // Derived channel aIndex.
+    int Output(byte aIndex) { return _Outputs[aIndex]; }
+    byte OutputCount() { return _OutputCount; }
+
+  private:
+    const byte* _Program;
+    int* _Outputs;
+    byte _OutputCount;
+};
+
+#endif // DERIVED_CHANNELS_H
+
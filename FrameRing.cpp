@@ -0,0 +1,168 @@
+/*
+ *  FrameRing.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "FrameRing.h"
+
+// Keeps the compiler from moving frame accesses across the Sequence updates.
+#define RING_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+//
+// Reads a counter that an interrupt may be updating.
+//
+// A multi-byte read on the AVR can be torn by an interrupt, so read until
+// two consecutive reads agree.
+//
+static unsigned long StableRead(const volatile unsigned long& aCounter)
+{
+  unsigned long value;
+  do
+    value = aCounter;
+  while(value != aCounter);
+
+  return value;
+}
+
+bool FrameRing::configure(NormalizedFrame aStorage[], byte aCapacity)
+{
+  if(aStorage == NULL || aCapacity == 0)
+    return false;
+
+  _Frames   = aStorage;
+  _Capacity = aCapacity;
+  _Head     = 0;
+
+  for(byte i=0; i<_Capacity; i++)
+    _Frames[i].Sequence = 0;
+
+  return true;
+}
+
+unsigned long FrameRing::Head() const
+{
+  return StableRead(_Head);
+}
+
+void FrameRing::Publish(DataNormalizer& aSource)
+{
+  if(_Frames == NULL)
+    return;
+
+  unsigned long sequence = _Head + 1;
+  NormalizedFrame* frame = &_Frames[(sequence - 1) % _Capacity];
+
+  frame->Sequence = 0;
+  RING_BARRIER();
+
+  byte count = aSource.SensorCount();
+  frame->SensorCount = count;
+  for(byte i=0; i<count; i++)
+  {
+    frame->Values[i]     = aSource.Values[i];
+    frame->Normalized[i] = aSource.Normalized[i];
+  }
+
+  RING_BARRIER();
+  frame->Sequence = sequence;
+  _Head = sequence;
+}
+
+void FrameRingReader::Attach(const FrameRing* aRing)
+{
+  _Ring     = aRing;
+  _Next     = aRing ? aRing->Head() + 1 : 1;
+  _Overruns = 0;
+  _Lost     = 0;
+}
+
+bool FrameRingReader::CatchUp(unsigned long aHead)
+{
+  if(aHead < _Next || aHead - _Next < _Ring->_Capacity)
+    return false;
+
+  // Resume with the oldest frame still held. If the writer has already
+  // started overwriting it, Peek() sees its Sequence change and skips it.
+  unsigned long oldest = aHead - _Ring->_Capacity + 1;
+
+  _Overruns++;
+  _Lost += oldest - _Next;
+  _Next = oldest;
+  return true;
+}
+
+const NormalizedFrame* FrameRingReader::Peek()
+{
+  if(_Ring == NULL || _Ring->_Frames == NULL)
+    return NULL;
+
+  for(;;)
+  {
+    unsigned long head = _Ring->Head();
+    CatchUp(head);
+
+    if(_Next > head)
+      return NULL;
+
+    const NormalizedFrame* frame = &_Ring->_Frames[(_Next - 1) % _Ring->_Capacity];
+    if(StableRead(frame->Sequence) == _Next)
+      return frame;
+
+    // The writer has begun overwriting this frame since Head() was read,
+    // so it is lost; try the next one.
+    _Overruns++;
+    _Lost++;
+    _Next++;
+  }
+}
+
+bool FrameRingReader::Release()
+{
+  if(_Ring == NULL || _Ring->_Frames == NULL)
+    return false;
+
+  const NormalizedFrame* frame = &_Ring->_Frames[(_Next - 1) % _Ring->_Capacity];
+
+  RING_BARRIER();
+  bool intact = StableRead(frame->Sequence) == _Next;
+  if(!intact)
+  {
+    _Overruns++;
+    _Lost++;
+  }
+
+  _Next++;
+  return intact;
+}
+
+FrameRingReader::ReadResults FrameRingReader::Read(NormalizedFrame& aFrame)
+{
+  unsigned long lost = _Lost;
+
+  for(;;)
+  {
+    const NormalizedFrame* frame = Peek();
+    if(frame == NULL)
+      return R_Empty;
+
+    memcpy((void*)&aFrame, (const void*)frame, sizeof(NormalizedFrame));
+
+    if(Release())
+      return _Lost != lost ? R_Overrun : R_Frame;
+
+    // The writer lapped us during the copy; go round again.
+  }
+}
+
@@ -0,0 +1,172 @@
+//
+//  FrameRing.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+//
+// One published frame: a copy of a normalizer's Values and Normalized arrays.
+//
+// Sequence is the 1-based number of the frame. It is 0 while the slot is
+// being overwritten.
+//
+struct NormalizedFrame
+{
+  volatile unsigned long Sequence;
+  byte SensorCount;
+  int Values[MAX_NUM_ANALOGUE_INPUTS];
+  int Normalized[MAX_NUM_ANALOGUE_INPUTS];
+};
+
+//
+// SUMMARY
+//
+// A ring of recent frames with one writer and any number of readers.
+//
+// PURPOSE
+//
+// Several consumers (a logger, a controller, a display) each want every
+// frame. The writer copies a frame into the ring once; each consumer keeps
+// its own cursor in a FrameRingReader, so the writer neither knows nor cares
+// how many consumers there are.
+//
+// USE
+//
+// The caller supplies the storage for the frames. A reader that falls more
+// than the ring's capacity behind loses the oldest frames; this is reported
+// as an overrun and the reader resumes with the oldest frame still held.
+//
+// The writer never waits, so Publish() may be called from an interrupt.
+//
+// EXAMPLE
+//
+// NormalizedFrame Storage[8];
+// FrameRing Ring;
+// FrameRingReader Logger, Display;
+//
+// Ring.configure(Storage, 8);
+// Logger.Attach(&Ring);
+// Display.Attach(&Ring);
+// ...
+// if(Sensors.ReadAndNormalize()) Ring.Publish(Sensors);
+// ...
+// const NormalizedFrame* frame = Logger.Peek();
+// if(frame) { ...use frame...; Logger.Release(); }
+//
+class FrameRing
+{
+  public:
+    FrameRing() : _Frames(NULL), _Capacity(0), _Head(0) {}
+
+    //
+    // aStorage  - the frames that make up the ring.
+    // aCapacity - the number of elements in aStorage.
+    //
+    // Returns false if there is no storage.
+    //
+    bool configure(NormalizedFrame aStorage[], byte aCapacity);
+
+    //
+    // Copies the latest Values and Normalized arrays of aSource into the ring,
+    // overwriting the oldest frame.
+    //
+    void Publish(DataNormalizer& aSource);
+
+    // The number of frames published so far, which is also the Sequence of
+    // the newest frame.
+    unsigned long Head() const;
+
+    byte Capacity() const { return _Capacity; }
+
+  private:
+    friend class FrameRingReader;
+
+    NormalizedFrame* _Frames;
+    byte _Capacity;
+    volatile unsigned long _Head;
+};
+
+//
+// A consumer's position in a FrameRing.
+//
+class FrameRingReader
+{
+  public:
+    // Returned by Read().
+    enum ReadResults
+    {
+      R_Empty,
+      R_Frame,
+      R_Overrun
+    };
+
+    FrameRingReader() : _Ring(NULL), _Next(1), _Overruns(0), _Lost(0) {}
+
+    //
+    // Starts reading aRing from the next frame to be published.
+    //
+    void Attach(const FrameRing* aRing);
+
+    //
+    // Returns a pointer to the next unread frame inside the ring, or NULL
+    // if there is none. The frame is not copied. Call Release() when done.
+    //
+    // If the reader had fallen behind, the lost frames are skipped and
+    // counted first.
+    //
+    const NormalizedFrame* Peek();
+
+    //
+    // Moves past the frame returned by Peek().
+    //
+    // Returns false if the writer overwrote that frame while it was in use,
+    // in which case its contents must be discarded; it counts as lost.
+    //
+    bool Release();
+
+    //
+    // Copies the next unread frame into aFrame and moves past it.
+    //
+    // Returns R_Empty if there is nothing new, R_Overrun if frames were lost
+    // before this one (aFrame still holds a good frame), otherwise R_Frame.
+    //
+    ReadResults Read(NormalizedFrame& aFrame);
+
+    // The number of times this reader has fallen behind, and the total number
+    // of frames it has lost.
+    unsigned long Overruns() const { return _Overruns; }
+    unsigned long Lost() const { return _Lost; }
+
+  private:
+    // Skips frames that have already been overwritten.
+    // Returns true if any were skipped.
+    bool CatchUp(unsigned long aHead);
+
+    const FrameRing* _Ring;
+
+    // Sequence of the next frame to read.
+    unsigned long _Next;
+
+    unsigned long _Overruns;
+    unsigned long _Lost;
+};
+
+#endif // FRAME_RING_H
+
@@ -0,0 +1,129 @@
+/*
+ *  FrameTranspose.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "FrameTranspose.h"
+
+#if defined(__SSE2__) && !defined(__AVR__)
+#include <emmintrin.h>
+#define FRAME_TRANSPOSE_SSE2 1
+#endif
+
+#if defined(FRAME_TRANSPOSE_SSE2)
+//
+// Transposes 4x4 blocks of 32-bit ints, four SSE2 loads and four stores a
+// block, covering the first four sensors. Rows are aFromStride ints
+// apart in aFrom and aToStride ints apart in aTo; the same shuffle turns
+// frames into sensors and back.
+//
+// Returns the number of frames done, a multiple of four.
+//
+static unsigned int Transpose4(const int* aFrom, unsigned int aFromStride, unsigned int aFromStep,
+                               int* aTo, unsigned int aToStride, unsigned int aToStep, unsigned int aFrames)
+{
+  unsigned int f = 0;
+
+  for(; f + 4 <= aFrames; f += 4)
+  {
+    __m128i r0 = _mm_loadu_si128((const __m128i*)(aFrom));
+    __m128i r1 = _mm_loadu_si128((const __m128i*)(aFrom + aFromStride));
+    __m128i r2 = _mm_loadu_si128((const __m128i*)(aFrom + 2 * aFromStride));
+    __m128i r3 = _mm_loadu_si128((const __m128i*)(aFrom + 3 * aFromStride));
+
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+    _mm_storeu_si128((__m128i*)(aTo),                 _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(aTo + aToStride),     _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(aTo + 2 * aToStride), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i*)(aTo + 3 * aToStride), _mm_unpackhi_epi64(t2, t3));
+
+    aFrom += aFromStep;
+    aTo   += aToStep;
+  }
+
+  return f;
+}
+#endif
+
+void FrameTranspose::ToPlanar(const int aInterleaved[], unsigned int aFrames, byte aSensors, int aPlanar[])
+{
+  unsigned int first = 0;
+
+#if defined(FRAME_TRANSPOSE_SSE2)
+  // Sensors 0-3 of four frames in, four readings of each of them out.
+  if(aSensors >= 4 && sizeof(int) == 4)
+    first = Transpose4(aInterleaved, aSensors, 4 * aSensors, aPlanar, aFrames, 4, aFrames);
+#endif
+
+  for(byte s=0; s<aSensors; s++)
+  {
+    // Sensors past the fourth were left out of the blocks above.
+    unsigned int f = s < 4 ? first : 0;
+    const int* from = aInterleaved + f * aSensors + s;
+    int* to = aPlanar + (unsigned int)s * aFrames;
+
+    for(; f + 4 <= aFrames; f += 4)
+    {
+      to[f]   = from[0];
+      to[f+1] = from[aSensors];
+      to[f+2] = from[2 * aSensors];
+      to[f+3] = from[3 * aSensors];
+      from += 4 * aSensors;
+    }
+
+    for(; f < aFrames; f++)
+    {
+      to[f] = *from;
+      from += aSensors;
+    }
+  }
+}
+
+void FrameTranspose::ToInterleaved(const int aPlanar[], unsigned int aFrames, byte aSensors, int aInterleaved[])
+{
+  unsigned int first = 0;
+
+#if defined(FRAME_TRANSPOSE_SSE2)
+  if(aSensors >= 4 && sizeof(int) == 4)
+    first = Transpose4(aPlanar, aFrames, 4, aInterleaved, aSensors, 4 * aSensors, aFrames);
+#endif
+
+  for(byte s=0; s<aSensors; s++)
+  {
+    unsigned int f = s < 4 ? first : 0;
+    const int* from = aPlanar + (unsigned int)s * aFrames;
+    int* to = aInterleaved + f * aSensors + s;
+
+    for(; f + 4 <= aFrames; f += 4)
+    {
+      to[0]            = from[f];
+      to[aSensors]     = from[f+1];
+      to[2 * aSensors] = from[f+2];
+      to[3 * aSensors] = from[f+3];
+      to += 4 * aSensors;
+    }
+
+    for(; f < aFrames; f++)
+    {
+      *to = from[f];
+      to += aSensors;
+    }
+  }
+}
+
@@ -0,0 +1,64 @@
+//
+//  FrameTranspose.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef FRAME_TRANSPOSE_H
+#define FRAME_TRANSPOSE_H
+
+#include "Arduino.h"
+
+//
+// SUMMARY
+//
+// Converts buffers of frames between the interleaved layout and the planar
+// layout.
+//
+// PURPOSE
+//
+// Captured frames arrive interleaved, as Values is laid out: sensor 0,
+// sensor 1, ..., then the next frame. Logs, filters and plots usually want
+// every reading of one sensor together. These routines reshuffle a whole
+// buffer at once.
+//
+// USE
+//
+// Interleaved: aBuffer[frame * aSensors + sensor]
+// Planar:      aBuffer[sensor * aFrames + frame]
+//
+// The source and destination must not overlap. Frames are moved four at a
+// time. On hosts with SSE2, the first four sensors of a buffer with four or
+// more are transposed in 4x4 blocks of vector registers; the remaining
+// sensors, buffers of fewer than four, and the AVR use plain copies.
+//
+// DataNormalizer::NormalizeInterleaved() and NormalizePlanar() accept either
+// layout directly, so there is no need to transpose just to normalize.
+//
+// EXAMPLE
+//
+// int Captured[64 * 4];   // 64 frames of 4 sensors, interleaved
+// int BySensor[64 * 4];
+//
+// FrameTranspose::ToPlanar(Captured, 64, 4, BySensor);
+//
+class FrameTranspose
+{
+  public:
+    static void ToPlanar(const int aInterleaved[], unsigned int aFrames, byte aSensors, int aPlanar[]);
+    static void ToInterleaved(const int aPlanar[], unsigned int aFrames, byte aSensors, int aInterleaved[]);
+};
+
+#endif // FRAME_TRANSPOSE_H
+
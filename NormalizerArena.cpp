@@ -0,0 +1,145 @@
+/*
+ *  NormalizerArena.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "NormalizerArena.h"
+
+NormalizerArena::NormalizerArena()
+  : _Instances(NULL), _InstanceCapacity(0), _InstanceCount(0),
+    _Tables(NULL), _TableCapacity(0), _TableUsed(0),
+    _LastNormalizedCopy(NULL), _LastNormalizedSize(0)
+{
+}
+
+bool NormalizerArena::configure(DataNormalizer aInstances[], byte aInstanceCapacity,
+                                int aTables[], unsigned int aTableCapacity)
+{
+  if(aInstances == NULL || aTables == NULL)
+    return false;
+
+  _Instances        = aInstances;
+  _InstanceCapacity = aInstanceCapacity;
+  _Tables           = aTables;
+  _TableCapacity    = aTableCapacity;
+
+  Reset();
+  return true;
+}
+
+DataNormalizer* NormalizerArena::Allocate()
+{
+  if(_InstanceCount >= _InstanceCapacity)
+    return NULL;
+
+  return &_Instances[_InstanceCount++];
+}
+
+const int* NormalizerArena::CopyTable(const int aTable[], byte aSize)
+{
+  if(aTable == NULL || _TableCapacity - _TableUsed < aSize)
+    return NULL;
+
+  int* copy = &_Tables[_TableUsed];
+  for(byte i=0; i<aSize; i++)
+    copy[i] = aTable[i];
+
+  _TableUsed += aSize;
+  return copy;
+}
+
+DataNormalizer* NormalizerArena::Create(const byte aNumberOfSensors, BaseAnalogRead* aSensorReaders[],
+                                        const byte aVectorSize, const int* aCalibrationVectors[], const int aNormalizedVector[])
+{
+  if(_InstanceCount >= _InstanceCapacity)
+    return NULL;
+
+  // Remember where we were so that a failure consumes nothing.
+  unsigned int mark = _TableUsed;
+  const int* lastCopy = _LastNormalizedCopy;
+  byte lastSize       = _LastNormalizedSize;
+
+  const int* calibration[MAX_NUM_ANALOGUE_INPUTS];
+  const int* normalized = NULL;
+  bool ok = aNumberOfSensors <= MAX_NUM_ANALOGUE_INPUTS && aCalibrationVectors != NULL;
+
+  for(byte i=0; ok && i<aNumberOfSensors; i++)
+  {
+    calibration[i] = CopyTable(aCalibrationVectors[i], aVectorSize);
+    ok = calibration[i] != NULL;
+  }
+
+  if(ok)
+  {
+    // Compared by contents, not by address: a caller may refill the same
+    // temporary array with a different vector for each board.
+    if(aNormalizedVector != NULL && _LastNormalizedCopy != NULL && aVectorSize == _LastNormalizedSize
+       && memcmp(aNormalizedVector, _LastNormalizedCopy, aVectorSize * sizeof(int)) == 0)
+      normalized = _LastNormalizedCopy;
+    else
+    {
+      normalized = CopyTable(aNormalizedVector, aVectorSize);
+      _LastNormalizedCopy = normalized;
+      _LastNormalizedSize = aVectorSize;
+    }
+    ok = normalized != NULL;
+  }
+
+  DataNormalizer* instance = &_Instances[_InstanceCount];
+
+  if(ok)
+    ok = instance->configure(aNumberOfSensors, aSensorReaders, aVectorSize, calibration, normalized);
+
+  if(!ok)
+  {
+    _TableUsed          = mark;
+    _LastNormalizedCopy = lastCopy;
+    _LastNormalizedSize = lastSize;
+    return NULL;
+  }
+
+  _InstanceCount++;
+  return instance;
+}
+
+void NormalizerArena::Reset()
+{
+  for(byte i=0; i<_InstanceCount; i++)
+    _Instances[i] = DataNormalizer();
+
+  _InstanceCount      = 0;
+  _TableUsed          = 0;
+  _LastNormalizedCopy = NULL;
+  _LastNormalizedSize = 0;
+}
+
+unsigned long NormalizerArena::BytesUsed()
+{
+  return (unsigned long)_InstanceCount * sizeof(DataNormalizer) + (unsigned long)_TableUsed * sizeof(int);
+}
+
+unsigned int NormalizerArena::BytesPerInstance()
+{
+  if(_InstanceCount == 0)
+    return 0;
+
+  return BytesUsed() / _InstanceCount;
+}
+
+unsigned int NormalizerArena::Footprint(byte aNumberOfSensors, byte aVectorSize)
+{
+  return sizeof(DataNormalizer) + (aNumberOfSensors + 1) * aVectorSize * sizeof(int);
+}
+
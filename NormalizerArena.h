@@ -0,0 +1,137 @@
+//
+//  NormalizerArena.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef NORMALIZER_ARENA_H
+#define NORMALIZER_ARENA_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+//
+// SUMMARY
+//
+// Hands out DataNormalizer objects and their calibration tables from two
+// blocks of storage supplied by the caller.
+//
+// PURPOSE
+//
+// When one program looks after many boards, creating a normalizer and
+// copies of its tables for each one scatters small allocations about the
+// heap. The arena instead places the objects side by side in one array and
+// the tables side by side in another, so memory use is known up front,
+// nothing is fragmented, and everything can be released at once.
+//
+// USE
+//
+// Create() takes the same arguments as DataNormalizer::configure(). It
+// copies the calibration vectors and the normalized vector into the table
+// storage and configures the next free object to use the copies, so the
+// caller's arrays may be temporary. Consecutive Create() calls whose
+// normalized vectors hold the same values share a single copy of it.
+//
+// Reset() returns every object to the uninitialized state and empties the
+// table storage. Pointers previously handed out must not be used after it.
+//
+// Because the arena never allocates, where its objects and tables live is
+// wholly up to the caller. On a multi-socket host, give each worker its own
+// arena, with both blocks allocated on that worker's node, so that its
+// normalizers and tables stay local to it.
+//
+// The library itself does not pin threads or choose nodes, and no locality
+// gain has been measured. On Linux the host program can do both, for
+// instance with pthread_setaffinity_np() and libnuma's numa_alloc_onnode().
+//
+// EXAMPLE
+//
+// DataNormalizer Boards[32];
+// int Tables[32 * 5 * 16];
+// NormalizerArena Arena;
+//
+// Arena.configure(Boards, 32, Tables, 32 * 5 * 16);
+// DataNormalizer* board = Arena.Create(SENSOR_COUNT, Readers, VECTOR_SIZE, CalibrationVectors, Aperture);
+//
+class NormalizerArena
+{
+  public:
+    NormalizerArena();
+
+    //
+    // aInstances        - storage for the normalizer objects.
+    // aInstanceCapacity - the number of elements in aInstances.
+    // aTables           - storage for copies of calibration data.
+    // aTableCapacity    - the number of elements in aTables.
+    //
+    // Returns false if either block is missing.
+    //
+    bool configure(DataNormalizer aInstances[], byte aInstanceCapacity,
+                   int aTables[], unsigned int aTableCapacity);
+
+    //
+    // Returns the next unused, unconfigured object, or NULL if there is none.
+    //
+    DataNormalizer* Allocate();
+
+    //
+    // Copies aSize elements of aTable into the table storage.
+    //
+    // Returns the copy, or NULL if there is not enough room.
+    //
+    const int* CopyTable(const int aTable[], byte aSize);
+
+    //
+    // Allocates an object, copies its tables into the arena, and configures it.
+    //
+    // Returns NULL if the arena is full, a vector is missing, or configure()
+    // rejects the arguments. Nothing is consumed in any of those cases.
+    //
+    DataNormalizer* Create(const byte aNumberOfSensors, BaseAnalogRead* aSensorReaders[],
+                           const byte aVectorSize, const int* aCalibrationVectors[], const int aNormalizedVector[]);
+
+    //
+    // Releases all objects and tables at once.
+    //
+    void Reset();
+
+    byte InstanceCount() { return _InstanceCount; }
+    unsigned int TableEntriesUsed() { return _TableUsed; }
+
+    // Bytes of both blocks in use, in total and per object handed out.
+    unsigned long BytesUsed();
+    unsigned int BytesPerInstance();
+
+    //
+    // The bytes that Create() uses for one object with the given shape,
+    // assuming its normalized vector is not shared with the previous one.
+    //
+    static unsigned int Footprint(byte aNumberOfSensors, byte aVectorSize);
+
+  private:
+    DataNormalizer* _Instances;
+    byte _InstanceCapacity;
+    byte _InstanceCount;
+
+    int* _Tables;
+    unsigned int _TableCapacity;
+    unsigned int _TableUsed;
+
+    // The copy of the normalized vector most recently copied by Create().
+    const int* _LastNormalizedCopy;
+    byte _LastNormalizedSize;
+};
+
+#endif // NORMALIZER_ARENA_H
+
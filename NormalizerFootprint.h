@@ -0,0 +1,163 @@
+//
+//  NormalizerFootprint.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef NORMALIZER_FOOTPRINT_H
+#define NORMALIZER_FOOTPRINT_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+#include "AdaptiveSampler.h"
+#include "CompensationMemo.h"
+#include "DerivedChannels.h"
+#include "FrameRing.h"
+#include "NormalizerMetrics.h"
+#include "OverloadController.h"
+#include "PriorityScheduler.h"
+#include "RawFrameQueue.h"
+#include "ScanPlanner.h"
+#include "SegmentProfile.h"
+#include "SharedAcquisition.h"
+#include "TableBuilder.h"
+#include "TraceReplay.h"
+#include "WarmStart.h"
+
+//
+// The optional parts of a configuration, for the OPTIONS argument below.
+//
+const unsigned int FOOTPRINT_SAMPLER    = 0x001;
+const unsigned int FOOTPRINT_PLANNER    = 0x002;
+const unsigned int FOOTPRINT_METRICS    = 0x004;
+const unsigned int FOOTPRINT_OVERLOAD   = 0x008;
+const unsigned int FOOTPRINT_SCHEDULER  = 0x010;
+const unsigned int FOOTPRINT_PROFILES   = 0x020;
+const unsigned int FOOTPRINT_DERIVED    = 0x040;
+const unsigned int FOOTPRINT_SHARED     = 0x080;
+const unsigned int FOOTPRINT_BUILDER    = 0x100;
+const unsigned int FOOTPRINT_WARM_START = 0x200;
+
+//
+// SUMMARY
+//
+// The SRAM a normalizer configuration uses, worked out by the compiler.
+//
+// PURPOSE
+//
+// On the Uno every byte of SRAM counts, and an overflow shows up only as a
+// device that misbehaves. Describing the configuration once as a type puts
+// its size where the compiler can check it against a budget, so that
+// turning on one more memo or a longer queue fails the build rather than
+// the device.
+//
+// USE
+//
+// SENSORS and VECTOR_SIZE are as for DataNormalizer::configure(). OPTIONS
+// is a combination of the FOOTPRINT_ flags. MEMO_ENTRIES is the capacity of
+// each sensor's memo, or 0 for none; RING_FRAMES, QUEUE_FRAMES and
+// CHECKPOINTS are the capacities of a FrameRing, a RawFrameQueue and a
+// TraceReplay, or 0 for none.
+//
+// Each member is a byte count that includes the objects themselves and
+// the storage they are configured with. Tables counts the calibration
+// vectors and the normalized vector, which the library reads from SRAM.
+// FOOTPRINT_WARM_START counts the WarmStart image, which the EEPROM
+// helpers hold on the stack while they run. Ram is the total.
+//
+// Not counted: a DerivedChannels program and its outputs, whose sizes are
+// the sketch's own, and the caller's arrays of readers and normalizers.
+//
+// Flash use depends on what the linker keeps and cannot be known here;
+// avr-size reports it after the build.
+//
+// NORMALIZER_ASSERT_BUDGET() stops the build if Ram exceeds a budget.
+// Report() prints the breakdown at run time for a quick look.
+//
+// EXAMPLE
+//
+// typedef NormalizerFootprint<4, 16, FOOTPRINT_SAMPLER | FOOTPRINT_METRICS, 64> Footprint;
+// NORMALIZER_ASSERT_BUDGET(Footprint, 1024);
+//
+// Footprint::Report(Serial);
+//
+template <byte SENSORS, byte VECTOR_SIZE, unsigned int OPTIONS = 0,
+          unsigned int MEMO_ENTRIES = 0, byte RING_FRAMES = 0, byte QUEUE_FRAMES = 0,
+          unsigned int CHECKPOINTS = 0>
+class NormalizerFootprint
+{
+  public:
+    static const unsigned long Normalizer = sizeof(DataNormalizer);
+
+    static const unsigned long Tables = (unsigned long)(SENSORS + 1) * VECTOR_SIZE * sizeof(int);
+
+    static const unsigned long Memos = MEMO_ENTRIES == 0 ? 0
+      : SENSORS * (sizeof(CompensationMemo) + (unsigned long)MEMO_ENTRIES * sizeof(MemoEntry));
+
+    static const unsigned long Profiles = !(OPTIONS & FOOTPRINT_PROFILES) ? 0
+      : SENSORS * (sizeof(SegmentProfile) + (VECTOR_SIZE + 1) * (sizeof(unsigned int) + sizeof(byte)));
+
+    static const unsigned long Attachments =
+        ((OPTIONS & FOOTPRINT_SAMPLER)   ? sizeof(AdaptiveSampler)    : 0)
+      + ((OPTIONS & FOOTPRINT_PLANNER)   ? sizeof(ScanPlanner)        : 0)
+      + ((OPTIONS & FOOTPRINT_METRICS)   ? sizeof(NormalizerMetrics)  : 0)
+      + ((OPTIONS & FOOTPRINT_OVERLOAD)  ? sizeof(OverloadController) : 0)
+      + ((OPTIONS & FOOTPRINT_SCHEDULER) ? sizeof(PriorityScheduler)  : 0)
+      + ((OPTIONS & FOOTPRINT_DERIVED)   ? sizeof(DerivedChannels)    : 0)
+      + ((OPTIONS & FOOTPRINT_SHARED)    ? sizeof(SharedAcquisition)  : 0)
+      + ((OPTIONS & FOOTPRINT_BUILDER)   ? sizeof(TableBuilder)       : 0);
+
+    static const unsigned long Buffers =
+        (RING_FRAMES  ? sizeof(FrameRing)     + (unsigned long)RING_FRAMES  * sizeof(NormalizedFrame)  : 0)
+      + (QUEUE_FRAMES ? sizeof(RawFrameQueue) + (unsigned long)QUEUE_FRAMES * sizeof(RawFrame)         : 0)
+      + (CHECKPOINTS  ? sizeof(TraceReplay)   + (unsigned long)CHECKPOINTS  * sizeof(ReplayCheckpoint) : 0)
+      + ((OPTIONS & FOOTPRINT_WARM_START) ? WARM_START_BYTES : 0);
+
+    static const unsigned long Ram = Normalizer + Tables + Memos + Profiles + Attachments + Buffers;
+
+    static void Report(Print& aOut)
+    {
+      aOut.print(F("normalizer  ")); aOut.println(Normalizer);
+      aOut.print(F("tables      ")); aOut.println(Tables);
+      aOut.print(F("memos       ")); aOut.println(Memos);
+      aOut.print(F("profiles    ")); aOut.println(Profiles);
+      aOut.print(F("attachments ")); aOut.println(Attachments);
+      aOut.print(F("buffers     ")); aOut.println(Buffers);
+      aOut.print(F("total       ")); aOut.println(Ram);
+    }
+
+  private:
+    // Configurations the library would refuse at run time fail here instead.
+    typedef char CheckSensors[SENSORS <= MAX_NUM_ANALOGUE_INPUTS ? 1 : -1];
+    typedef char CheckVectorSize[VECTOR_SIZE >= 2 ? 1 : -1];
+    typedef char CheckMemo[(MEMO_ENTRIES & (MEMO_ENTRIES - 1)) == 0 ? 1 : -1];
+    typedef char CheckQueue[(QUEUE_FRAMES & (QUEUE_FRAMES - 1)) == 0 && QUEUE_FRAMES <= 128 ? 1 : -1];
+};
+
+//
+// Stops the build if configuration aFootprint, a NormalizerFootprint type,
+// needs more than aBytes of SRAM.
+//
+#if __cplusplus >= 201103L
+#define NORMALIZER_ASSERT_BUDGET(aFootprint, aBytes) \
+  static_assert(aFootprint::Ram <= (unsigned long)(aBytes), "normalizer configuration exceeds its SRAM budget")
+#else
+#define NORMALIZER_BUDGET_NAME2(aLine) NormalizerBudget##aLine
+#define NORMALIZER_BUDGET_NAME(aLine) NORMALIZER_BUDGET_NAME2(aLine)
+#define NORMALIZER_ASSERT_BUDGET(aFootprint, aBytes) \
+  typedef char NORMALIZER_BUDGET_NAME(__LINE__)[aFootprint::Ram <= (unsigned long)(aBytes) ? 1 : -1]
+#endif
+
+#endif // NORMALIZER_FOOTPRINT_H
+
@@ -0,0 +1,167 @@
+/*
+ *  NormalizerMetrics.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "NormalizerMetrics.h"
+
+// Keeps the compiler from moving counter accesses across the Sequence updates.
+#define METRICS_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+// How many times Snapshot() retries before giving up.
+const byte SNAPSHOT_ATTEMPTS = 4;
+
+#if defined(__AVR__)
+//
+// Reads the sequence, which the writer may change in an interrupt part way
+// through a 16-bit read on AVR, by reading until two reads agree.
+//
+static unsigned int StableRead(const volatile unsigned int& aCounter)
+{
+  unsigned int value;
+  do
+    value = aCounter;
+  while(value != aCounter);
+
+  return value;
+}
+#endif
+
+//
+// On the AVR the only other party is an interrupt on the same core, so
+// keeping the compiler in order is enough. Elsewhere the observer may run
+// on another core, and the fences keep the counter stores and loads on the
+// right side of the Sequence updates as the other core sees them.
+//
+void NormalizerMetrics::BeginUpdate()
+{
+#if defined(__AVR__)
+  Sequence++;
+  METRICS_BARRIER();
+#else
+  __atomic_store_n(&Sequence, Sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+#endif
+}
+
+void NormalizerMetrics::EndUpdate()
+{
+#if defined(__AVR__)
+  METRICS_BARRIER();
+  Sequence++;
+#else
+  __atomic_store_n(&Sequence, Sequence + 1, __ATOMIC_RELEASE);
+#endif
+}
+
+bool NormalizerMetrics::Snapshot(NormalizerMetrics& aCopy) const
+{
+  for(byte attempt=0; attempt<SNAPSHOT_ATTEMPTS; attempt++)
+  {
+#if defined(__AVR__)
+    unsigned int before = StableRead(Sequence);
+#else
+    unsigned int before = __atomic_load_n(&Sequence, __ATOMIC_ACQUIRE);
+#endif
+    if(before & 1)
+      continue;
+
+    METRICS_BARRIER();
+    memcpy((void*)&aCopy, (const void*)this, sizeof(NormalizerMetrics));
+
+#if defined(__AVR__)
+    METRICS_BARRIER();
+    unsigned int after = StableRead(Sequence);
+#else
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    unsigned int after = __atomic_load_n(&Sequence, __ATOMIC_RELAXED);
+#endif
+
+    if(after == before)
+      return true;
+  }
+
+  return false;
+}
+
+void NormalizerMetrics::Report(Print& aOut) const
+{
+  NormalizerMetrics copy;
+  if(!Snapshot(copy))
+  {
+    aOut.println(F("metrics busy"));
+    return;
+  }
+
+  unsigned long elapsed = millis() - copy.StartMillis;
+
+  aOut.print(F("metrics v"));
+  aOut.println(copy.Version);
+
+  aOut.print(F("frames: "));
+  aOut.println(copy.Frames);
+
+  aOut.print(F("frames/s: "));
+  aOut.println(elapsed == 0 ? 0UL : (unsigned long)((uint64_t)copy.Frames * 1000 / elapsed));
+
+  aOut.print(F("read us (last/avg): "));
+  aOut.print(copy.ReadMicros);
+  aOut.print('/');
+  aOut.println(copy.Frames == 0 ? 0UL : (unsigned long)(copy.TotalReadMicros / copy.Frames));
+
+  aOut.print(F("normalize us (last/avg): "));
+  aOut.print(copy.NormalizeMicros);
+  aOut.print('/');
+  aOut.println(copy.Frames == 0 ? 0UL : (unsigned long)(copy.TotalNormalizeMicros / copy.Frames));
+
+  aOut.print(F("saturated low/high:"));
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    aOut.print(' ');
+    aOut.print(copy.SaturatedLow[i]);
+    aOut.print('/');
+    aOut.print(copy.SaturatedHigh[i]);
+  }
+  aOut.println();
+
+  aOut.print(F("queue depth/dropped: "));
+  aOut.print(copy.QueueDepth);
+  aOut.print('/');
+  aOut.println(copy.QueueDropped);
+}
+
+void NormalizerMetrics::Reset()
+{
+  BeginUpdate();
+
+  Version              = NORMALIZER_METRICS_VERSION;
+  StartMillis          = millis();
+  Frames               = 0;
+  ReadMicros           = 0;
+  NormalizeMicros      = 0;
+  TotalReadMicros      = 0;
+  TotalNormalizeMicros = 0;
+  QueueDepth           = 0;
+  QueueDropped         = 0;
+
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    SaturatedLow[i]  = 0;
+    SaturatedHigh[i] = 0;
+  }
+
+  EndUpdate();
+}
+
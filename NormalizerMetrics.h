@@ -0,0 +1,119 @@
+//
+//  NormalizerMetrics.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef NORMALIZER_METRICS_H
+#define NORMALIZER_METRICS_H
+
+#include <stdint.h>
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+// Bumped whenever the layout of NormalizerMetrics changes, so that an
+// observer can tell whether it understands the block it is looking at.
+const byte NORMALIZER_METRICS_VERSION = 3;
+
+//
+// SUMMARY
+//
+// A block of counters that a DataNormalizer updates as it works.
+//
+// PURPOSE
+//
+// It lets a monitor (a serial reporter in loop(), a debugger, or another
+// task) watch the normalizer without the normalizer ever waiting on it.
+//
+// USE
+//
+// The normalizer is the only writer. It bumps Sequence to an odd number
+// before it touches the counters and back to an even number afterwards.
+// Observers call Snapshot(), which copies the block and retries if the
+// writer was active during the copy. The writer never checks for readers,
+// so it is safe for the normalizer to run from an interrupt handler while
+// loop() reports on it. Off the AVR, Sequence is updated and read with
+// atomic operations and fences, so the observer may run on another core.
+//
+// The counters wrap: Frames after 2^32 frames, the totals after 2^64
+// microseconds. Frames per second in Report() are measured with millis(),
+// so they are only meaningful within 49 days of Reset().
+//
+// EXAMPLE
+//
+// NormalizerMetrics Metrics;
+// Sensors.AttachMetrics(&Metrics);
+// ...
+// Metrics.Report(Serial);
+//
+class NormalizerMetrics
+{
+  public:
+    NormalizerMetrics() : Sequence(0) { Reset(); }
+
+    // Layout version; always NORMALIZER_METRICS_VERSION.
+    byte Version;
+
+    // Odd while the writer is updating the block.
+    volatile unsigned int Sequence;
+
+    // millis() when the counters were last reset.
+    unsigned long StartMillis;
+
+    // Number of frames normalized.
+    unsigned long Frames;
+
+    // Duration of the latest Read() and Normalize(), in microseconds.
+    unsigned long ReadMicros;
+    unsigned long NormalizeMicros;
+
+    // Running totals of the above. 32 bits would wrap after 71 minutes.
+    uint64_t TotalReadMicros;
+    uint64_t TotalNormalizeMicros;
+
+    // Number of readings that fell below/above the calibration range.
+    unsigned long SaturatedLow[MAX_NUM_ANALOGUE_INPUTS];
+    unsigned long SaturatedHigh[MAX_NUM_ANALOGUE_INPUTS];
+
+    // Frames waiting in, and dropped by, an attached RawFrameQueue.
+    unsigned int QueueDepth;
+    unsigned int QueueDropped;
+
+    //
+    // Writer side. Every update must be bracketed by these.
+    //
+    void BeginUpdate();
+    void EndUpdate();
+
+    //
+    // Copies a consistent view of the counters into aCopy.
+    //
+    // Returns false if the writer kept the block busy for every attempt.
+    // That can only happen when called from an interrupt that preempted
+    // the writer, in which case it should simply be tried later.
+    //
+    bool Snapshot(NormalizerMetrics& aCopy) const;
+
+    //
+    // Takes a snapshot and prints it in a human readable form.
+    // Frames per second are derived from Frames and StartMillis.
+    //
+    void Report(Print& aOut) const;
+
+    // Zeroes all of the counters.
+    void Reset();
+};
+
+#endif // NORMALIZER_METRICS_H
+
@@ -0,0 +1,101 @@
+/*
+ *  OverloadController.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "OverloadController.h"
+
+OverloadController::OverloadController()
+  : _Level(0), _Log(NULL), _Shed(0), _Transitions(0)
+{
+  // Defaults suit a queue of 16 frames: shed a little at half full,
+  // more at three quarters, most when nearly full.
+  _Enter[0] = 0;
+  _Leave[0] = 0;
+  SetThresholds(1,  8, 2);
+  SetThresholds(2, 12, 6);
+  SetThresholds(3, 15, 10);
+}
+
+void OverloadController::SetThresholds(byte aLevel, unsigned int aEnter, unsigned int aLeave)
+{
+  if(aLevel == 0 || aLevel > MAX_OVERLOAD_LEVEL)
+    return;
+
+  _Enter[aLevel] = aEnter;
+  _Leave[aLevel] = aLeave < aEnter ? aLeave : aEnter;
+}
+
+byte OverloadController::Update(unsigned int aBacklog)
+{
+  byte level = _Level;
+
+  while(level < MAX_OVERLOAD_LEVEL && aBacklog >= _Enter[level + 1])
+    level++;
+
+  while(level > 0 && aBacklog <= _Leave[level] && aBacklog < _Enter[level])
+    level--;
+
+  if(level == _Level)
+    return _Level;
+
+  OverloadTransition& entry = _History[_Transitions % OVERLOAD_HISTORY];
+  entry.Millis  = millis();
+  entry.Backlog = aBacklog;
+  entry.From    = _Level;
+  entry.To      = level;
+  _Transitions++;
+
+  if(_Log)
+  {
+    _Log->print(F("overload "));
+    _Log->print(_Level);
+    _Log->print(F("->"));
+    _Log->print(level);
+    _Log->print(F(" backlog "));
+    _Log->print(aBacklog);
+    _Log->print(F(" at "));
+    _Log->println(entry.Millis);
+  }
+
+  _Level = level;
+  return _Level;
+}
+
+byte OverloadController::SkipMask(byte aSheddable, byte aPhase)
+{
+  if(_Level == 0 || aSheddable == 0)
+    return 0;
+
+  // One frame in 2^level is normalized in full.
+  byte period = 1 << _Level;
+  if((aPhase & (period - 1)) == 0)
+    return 0;
+
+  for(byte bits=aSheddable; bits; bits &= bits - 1)
+    _Shed++;
+
+  return aSheddable;
+}
+
+bool OverloadController::History(byte aAge, OverloadTransition& aTransition)
+{
+  if(aAge >= OVERLOAD_HISTORY || aAge >= _Transitions)
+    return false;
+
+  aTransition = _History[(_Transitions - 1 - aAge) % OVERLOAD_HISTORY];
+  return true;
+}
+
@@ -0,0 +1,124 @@
+//
+//  OverloadController.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef OVERLOAD_CONTROLLER_H
+#define OVERLOAD_CONTROLLER_H
+
+#include "Arduino.h"
+
+// The deepest level of shedding. At level n sheddable sensors are
+// normalized on one frame in 2^n.
+const byte MAX_OVERLOAD_LEVEL = 3;
+
+// The number of transitions kept in the history.
+const byte OVERLOAD_HISTORY = 8;
+
+//
+// One change of level, for the record.
+//
+struct OverloadTransition
+{
+  unsigned long Millis;
+  unsigned int Backlog;
+  byte From;
+  byte To;
+};
+
+//
+// SUMMARY
+//
+// Sheds normalization work while a backlog is too long.
+//
+// PURPOSE
+//
+// Bursts from many sources can outrun the normalizers, and a queue that
+// grows without limit is worse than slightly stale readings. The controller
+// watches the backlog and, past a threshold, has the attached normalizers
+// skip their sheddable sensors on some frames, restoring them once the
+// backlog has drained.
+//
+// USE
+//
+// Call Update() with the current backlog (for instance RawFrameQueue's
+// Depth()) once per batch. Each level has an entry and an exit threshold;
+// the gap between them stops the level flapping. Only sensors marked
+// sheddable in a normalizer are affected; skipped sensors keep their
+// previous Normalized values.
+//
+// Every change of level is kept in a short history and, if a log is set,
+// printed to it, so the effect on data quality can be traced afterwards.
+//
+// EXAMPLE
+//
+// OverloadController Overload;
+// Overload.SetLog(&Serial);
+// BoardA.AttachOverload(&Overload, 0x3C);   // sensors 2..5 may be shed
+// ...
+// Queue.Drain(Pool, 2, 8, OnFrame);
+// Overload.Update(Queue.Depth());
+//
+class OverloadController
+{
+  public:
+    OverloadController();
+
+    //
+    // The backlog at or above which aLevel is entered, and at or below
+    // which it is left again. aLevel runs from 1 to MAX_OVERLOAD_LEVEL.
+    //
+    void SetThresholds(byte aLevel, unsigned int aEnter, unsigned int aLeave);
+
+    // Where to print transitions, or NULL for nowhere.
+    void SetLog(Print* aLog) { _Log = aLog; }
+
+    //
+    // Moves to the level called for by aBacklog.
+    //
+    // Returns the current level.
+    //
+    byte Update(unsigned int aBacklog);
+
+    byte Level() { return _Level; }
+
+    //
+    // The sensors of aSheddable to skip on the frame numbered aPhase.
+    // Called by DataNormalizer::Normalize().
+    //
+    byte SkipMask(byte aSheddable, byte aPhase);
+
+    // Normalizations skipped so far, across all normalizers.
+    unsigned long Shed() { return _Shed; }
+
+    // The number of transitions so far, and the most recent ones;
+    // aAge 0 is the latest. Returns false if there is no such entry.
+    unsigned long Transitions() { return _Transitions; }
+    bool History(byte aAge, OverloadTransition& aTransition);
+
+  private:
+    unsigned int _Enter[MAX_OVERLOAD_LEVEL + 1];
+    unsigned int _Leave[MAX_OVERLOAD_LEVEL + 1];
+
+    byte _Level;
+    Print* _Log;
+
+    unsigned long _Shed;
+    unsigned long _Transitions;
+    OverloadTransition _History[OVERLOAD_HISTORY];
+};
+
+#endif // OVERLOAD_CONTROLLER_H
+
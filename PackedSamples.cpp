@@ -0,0 +1,189 @@
+/*
+ *  PackedSamples.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "PackedSamples.h"
+
+#if defined(__SSSE3__) && !defined(__AVR__)
+#include <tmmintrin.h>
+#define PACKED_SAMPLES_SSSE3 1
+#endif
+
+#if defined(PACKED_SAMPLES_SSSE3)
+//
+// Unpacks eight samples per step on hosts with SSSE3: two groups of 10-bit
+// samples from 10 bytes, or four groups of 12-bit samples from 12 bytes.
+//
+// A byte shuffle puts the two bytes holding each sample into its own 16-bit
+// lane, high byte uppermost. The sample then sits at a different bit offset
+// in each lane, so a multiply shifts it to the top of the lane and one shift
+// right brings it down to bit 0.
+//
+// The 16-byte load reads beyond the eight samples, so steps are only taken
+// while it stays inside the aLength bytes that the caller's samples occupy.
+//
+// Returns the number of samples unpacked, a multiple of eight.
+//
+static unsigned long UnpackVector(const byte* aPacked, byte aFormat, unsigned long aCount, unsigned long aLength, int* aOut)
+{
+  static const char Shuffle[4][16] = {
+    { 0, 1,  1, 2,  2, 3,  3, 4,  5, 6,  6, 7,  7, 8,  8, 9 },   // PACKED_10_LE
+    { 1, 0,  2, 1,  3, 2,  4, 3,  6, 5,  7, 6,  8, 7,  9, 8 },   // PACKED_10_BE
+    { 0, 1,  1, 2,  3, 4,  4, 5,  6, 7,  7, 8,  9,10, 10,11 },   // PACKED_12_LE
+    { 1, 0,  2, 1,  4, 3,  5, 4,  7, 6,  8, 7, 10, 9, 11,10 }    // PACKED_12_BE
+  };
+
+  // 1 << (16 - bits - offset of the sample in its lane).
+  static const short Scale[4][8] = {
+    { 64, 16,  4,  1, 64, 16,  4,  1 },
+    {  1,  4, 16, 64,  1,  4, 16, 64 },
+    { 16,  1, 16,  1, 16,  1, 16,  1 },
+    {  1, 16,  1, 16,  1, 16,  1, 16 }
+  };
+
+  byte bits = aFormat == PACKED_10_LE || aFormat == PACKED_10_BE ? 10 : 12;
+  unsigned long step = bits;   // bytes per eight samples
+  const __m128i shuffle = _mm_loadu_si128((const __m128i*)Shuffle[aFormat]);
+  const __m128i scale   = _mm_loadu_si128((const __m128i*)Scale[aFormat]);
+  const __m128i zero    = _mm_setzero_si128();
+  unsigned long done = 0;
+
+  for(unsigned long used = 0; done + 8 <= aCount && used + 16 <= aLength; done += 8, used += step)
+  {
+    __m128i lanes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(aPacked + used)), shuffle);
+    lanes = _mm_srli_epi16(_mm_mullo_epi16(lanes, scale), 16 - bits);
+
+    _mm_storeu_si128((__m128i*)(aOut + done),     _mm_unpacklo_epi16(lanes, zero));
+    _mm_storeu_si128((__m128i*)(aOut + done + 4), _mm_unpackhi_epi16(lanes, zero));
+  }
+
+  return done;
+}
+#endif
+
+byte PackedSamples::Bits(byte aFormat)
+{
+  switch(aFormat)
+  {
+    case PACKED_10_LE:
+    case PACKED_10_BE: return 10;
+    case PACKED_12_LE:
+    case PACKED_12_BE: return 12;
+  }
+
+  return 0;
+}
+
+unsigned long PackedSamples::Bytes(byte aFormat, unsigned long aCount)
+{
+  return (aCount * Bits(aFormat) + 7) / 8;
+}
+
+//
+// Only the bytes the sample touches are read, so the last sample of a
+// buffer does not read past its end.
+//
+int PackedSamples::Extract(const byte aPacked[], byte aBits, bool aBigEndian, unsigned long aIndex)
+{
+  unsigned long bit = aIndex * aBits;
+  const byte* p = aPacked + bit / 8;
+  byte shift = bit % 8;
+  bool third = shift + aBits > 16;
+  unsigned int mask = (1 << aBits) - 1;
+
+  if(aBigEndian)
+  {
+    unsigned long word = ((unsigned long)p[0] << 16) | ((unsigned int)p[1] << 8) | (third ? p[2] : 0);
+    return (word >> (24 - shift - aBits)) & mask;
+  }
+
+  unsigned long word = p[0] | ((unsigned int)p[1] << 8) | (third ? (unsigned long)p[2] << 16 : 0);
+  return (word >> shift) & mask;
+}
+
+bool PackedSamples::Unpack(const byte aPacked[], byte aFormat, unsigned long aFirst, unsigned int aCount, int aOut[])
+{
+  byte bits = Bits(aFormat);
+  if(bits == 0)
+    return false;
+
+  bool bigEndian = aFormat == PACKED_10_BE || aFormat == PACKED_12_BE;
+
+  // Samples per whole-byte group: 4 in 5 bytes, or 2 in 3 bytes.
+  byte group = bits == 10 ? 4 : 2;
+  unsigned long end = aFirst + aCount;
+  unsigned long i = aFirst;
+
+  while(i < end && i % group != 0)
+    *aOut++ = Extract(aPacked, bits, bigEndian, i++);
+
+  const byte* p = aPacked + i / group * (bits == 10 ? 5 : 3);
+
+#if defined(PACKED_SAMPLES_SSSE3)
+  if(sizeof(int) == 4)
+  {
+    unsigned long done = UnpackVector(p, aFormat, end - i, aPacked + Bytes(aFormat, end) - p, aOut);
+    i    += done;
+    p    += done / 8 * bits;
+    aOut += done;
+  }
+#endif
+
+  switch(aFormat)
+  {
+    case PACKED_10_LE:
+      for(; i + 4 <= end; i += 4, p += 5, aOut += 4)
+      {
+        aOut[0] =  p[0]       | ((p[1] & 0x03) << 8);
+        aOut[1] = (p[1] >> 2) | ((p[2] & 0x0F) << 6);
+        aOut[2] = (p[2] >> 4) | ((p[3] & 0x3F) << 4);
+        aOut[3] = (p[3] >> 6) |  (p[4]         << 2);
+      }
+      break;
+
+    case PACKED_10_BE:
+      for(; i + 4 <= end; i += 4, p += 5, aOut += 4)
+      {
+        aOut[0] =  (p[0]         << 2) | (p[1] >> 6);
+        aOut[1] = ((p[1] & 0x3F) << 4) | (p[2] >> 4);
+        aOut[2] = ((p[2] & 0x0F) << 6) | (p[3] >> 2);
+        aOut[3] = ((p[3] & 0x03) << 8) |  p[4];
+      }
+      break;
+
+    case PACKED_12_LE:
+      for(; i + 2 <= end; i += 2, p += 3, aOut += 2)
+      {
+        aOut[0] =  p[0]       | ((p[1] & 0x0F) << 8);
+        aOut[1] = (p[1] >> 4) |  (p[2]         << 4);
+      }
+      break;
+
+    case PACKED_12_BE:
+      for(; i + 2 <= end; i += 2, p += 3, aOut += 2)
+      {
+        aOut[0] =  (p[0]         << 4) | (p[1] >> 4);
+        aOut[1] = ((p[1] & 0x0F) << 8) |  p[2];
+      }
+      break;
+  }
+
+  while(i < end)
+    *aOut++ = Extract(aPacked, bits, bigEndian, i++);
+
+  return true;
+}
+
@@ -0,0 +1,93 @@
+//
+//  PackedSamples.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef PACKED_SAMPLES_H
+#define PACKED_SAMPLES_H
+
+#include "Arduino.h"
+
+//
+// Packed sample formats. Samples follow each other with no padding, in a
+// continuous bit stream.
+//
+// LE - least significant bit first: sample 0 is the low bits of byte 0.
+// BE - most significant bit first: sample 0 is the high bits of byte 0.
+//
+enum PackedFormats
+{
+  PACKED_10_LE,
+  PACKED_10_BE,
+  PACKED_12_LE,
+  PACKED_12_BE
+};
+
+//
+// SUMMARY
+//
+// Unpacks tightly packed 10- and 12-bit samples into ints.
+//
+// PURPOSE
+//
+// External ADCs and the serial capture format carry samples packed to save
+// bandwidth: four 10-bit samples in five bytes, or two 12-bit samples in
+// three. Extracting them bit by bit costs about as much as normalizing them.
+// Here whole groups are taken apart with fixed shifts and masks.
+//
+// USE
+//
+// Unpack() takes the index of the first sample wanted, so a buffer holding
+// many frames can be unpacked a frame at a time. Groups that start on a
+// byte boundary take the fast path; samples before and after them are
+// extracted one at a time. On hosts built with SSSE3 (-mssse3 or a -march
+// that has it) the fast path takes eight samples per step in vector
+// registers; elsewhere, the AVR included, it is plain shifts and masks.
+//
+// DataNormalizer::UnpackFrame() unpacks straight into Values, and
+// NormalizePacked() unpacks and normalizes a whole buffer.
+//
+// EXAMPLE
+//
+// int Samples[8];
+// PackedSamples::Unpack(Packet, PACKED_12_BE, 0, 8, Samples);
+//
+class PackedSamples
+{
+  public:
+    //
+    // aPacked - the packed stream.
+    // aFormat - one of PackedFormats.
+    // aFirst  - the index in the stream of the first sample to unpack.
+    // aCount  - the number of samples to unpack.
+    // aOut    - where the samples go.
+    //
+    // Returns false if aFormat is unknown.
+    //
+    static bool Unpack(const byte aPacked[], byte aFormat, unsigned long aFirst, unsigned int aCount, int aOut[]);
+
+    // The number of bits per sample of aFormat, or 0 if unknown.
+    static byte Bits(byte aFormat);
+
+    // The number of bytes holding aCount samples of aFormat.
+    static unsigned long Bytes(byte aFormat, unsigned long aCount);
+
+  private:
+    // Extract the single sample aIndex.
+    static int Extract(const byte aPacked[], byte aBits, bool aBigEndian, unsigned long aIndex);
+};
+
+#endif // PACKED_SAMPLES_H
+
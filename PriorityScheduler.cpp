@@ -0,0 +1,124 @@
+/*
+ *  PriorityScheduler.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "PriorityScheduler.h"
+
+PriorityScheduler::PriorityScheduler()
+  : _Deferred(0)
+{
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    _Classes[i] = PRIORITY_CRITICAL;
+    _Order[i]   = i;
+    _Costs[i]   = 0;
+  }
+
+  ResetStatistics();
+}
+
+void PriorityScheduler::SetPriority(byte aIndex, byte aClass)
+{
+  if(aIndex < MAX_NUM_ANALOGUE_INPUTS)
+    _Classes[aIndex] = aClass;
+}
+
+void PriorityScheduler::ResetStatistics()
+{
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+    _Deferrals[i] = 0;
+
+  _TotalDeferrals = 0;
+}
+
+void PriorityScheduler::Order(byte aCount)
+{
+  for(byte i=0; i<aCount; i++)
+    _Order[i] = i;
+
+  // Insertion sort by class, then by whether deferred last time.
+  for(byte i=1; i<aCount; i++)
+  {
+    byte sensor = _Order[i];
+    byte j = i;
+
+    while(j > 0)
+    {
+      byte other = _Order[j-1];
+      bool before = _Classes[sensor] < _Classes[other]
+                 || (_Classes[sensor] == _Classes[other]
+                     && (_Deferred & (1 << sensor)) && !(_Deferred & (1 << other)));
+      if(!before)
+        break;
+
+      _Order[j] = other;
+      j--;
+    }
+
+    _Order[j] = sensor;
+  }
+}
+
+byte PriorityScheduler::Run(DataNormalizer& aNormalizer, unsigned long aBudgetMicros)
+{
+  if(aNormalizer.StatusCode() != DataNormalizer::S_OK)
+    return 0;
+
+  byte count = aNormalizer.SensorCount();
+  Order(count);
+
+  unsigned long start = micros();
+  byte serviced = 0;
+  byte deferred = 0;
+
+  for(byte k=0; k<count; k++)
+  {
+    byte i = _Order[k];
+    if(!aNormalizer.Enabled(i))
+      continue;
+
+    unsigned long now = micros();
+
+    // A sensor deferred last time goes ahead while any budget is left,
+    // even if its estimated cost does not fit, so that it cannot starve.
+    unsigned long used = now - start;
+    bool late = _Deferred & (1 << i);
+
+    if(_Classes[i] != PRIORITY_CRITICAL
+       && (used >= aBudgetMicros || (!late && used + _Costs[i] > aBudgetMicros)))
+    {
+      deferred |= 1 << i;
+      _Deferrals[i]++;
+      _TotalDeferrals++;
+      continue;
+    }
+
+    aNormalizer.ReadSensor(i);
+    aNormalizer.NormalizeSensor(i);
+    serviced++;
+
+    // Follow the cost with a light touch so one slow read does not
+    // keep the sensor deferred for long.
+    unsigned long cost = micros() - now;
+    if(cost > 0xFFFF)
+      cost = 0xFFFF;
+    _Costs[i] = ((unsigned long)_Costs[i] * 3 + cost) / 4;
+  }
+
+  _Deferred = deferred;
+  return serviced;
+}
+
@@ -0,0 +1,103 @@
+//
+//  PriorityScheduler.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef PRIORITY_SCHEDULER_H
+#define PRIORITY_SCHEDULER_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+// The priority class that is always serviced, whatever the budget.
+const byte PRIORITY_CRITICAL = 0;
+
+//
+// SUMMARY
+//
+// Reads and normalizes a normalizer's sensors in priority order within a
+// time budget.
+//
+// PURPOSE
+//
+// When control sensors and diagnostic sensors share one loop, an overrun
+// delays them all alike. The scheduler services the control sensors first,
+// every time, and defers the others to a later tick when the budget for this
+// one is spent.
+//
+// USE
+//
+// Each sensor has a class; lower classes come first and class 0
+// (PRIORITY_CRITICAL) is serviced even when the budget is exhausted.
+// Within a class, sensors deferred on the previous tick come first, and
+// they go ahead while any budget is left, so no sensor is starved while the
+// budget allows any work at all.
+//
+// Before servicing a sensor the scheduler compares the time left with that
+// sensor's recent cost, so it stops before overrunning rather than after.
+// Deferred sensors keep their previous Values and Normalized entries.
+//
+// EXAMPLE
+//
+// PriorityScheduler Scheduler;
+// Scheduler.SetPriority(0, PRIORITY_CRITICAL);
+// Scheduler.SetPriority(1, PRIORITY_CRITICAL);
+// Scheduler.SetPriority(4, 2);
+// ...
+// Scheduler.Run(Sensors, 500);   // in loop(), 500us per tick
+//
+class PriorityScheduler
+{
+  public:
+    PriorityScheduler();
+
+    void SetPriority(byte aIndex, byte aClass);
+    byte Priority(byte aIndex) { return _Classes[aIndex]; }
+
+    //
+    // Reads and normalizes the sensors of aNormalizer, most important first,
+    // stopping once aBudgetMicros would be exceeded.
+    //
+    // Returns the number of sensors serviced, or 0 if the normalizer is not
+    // configured.
+    //
+    byte Run(DataNormalizer& aNormalizer, unsigned long aBudgetMicros);
+
+    // The number of ticks on which sensor aIndex was deferred, and in total.
+    unsigned long Deferrals(byte aIndex) { return _Deferrals[aIndex]; }
+    unsigned long TotalDeferrals() { return _TotalDeferrals; }
+
+    // Sensors deferred on the latest tick, one bit per sensor.
+    byte Deferred() { return _Deferred; }
+
+    void ResetStatistics();
+
+  private:
+    // Puts the sensors in service order for this tick.
+    void Order(byte aCount);
+
+    byte _Classes[MAX_NUM_ANALOGUE_INPUTS];
+    byte _Order[MAX_NUM_ANALOGUE_INPUTS];
+
+    // Recent cost of each sensor, in microseconds.
+    unsigned int _Costs[MAX_NUM_ANALOGUE_INPUTS];
+
+    byte _Deferred;
+    unsigned long _Deferrals[MAX_NUM_ANALOGUE_INPUTS];
+    unsigned long _TotalDeferrals;
+};
+
+#endif // PRIORITY_SCHEDULER_H
+
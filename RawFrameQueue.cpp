@@ -0,0 +1,188 @@
+/*
+ *  RawFrameQueue.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "RawFrameQueue.h"
+#include "NormalizerMetrics.h"
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+#endif
+
+const byte MAX_QUEUE_CAPACITY = 128;
+
+bool RawFrameQueue::configure(RawFrame aSlots[], byte aCapacity)
+{
+  if(aSlots == NULL || aCapacity == 0 || aCapacity > MAX_QUEUE_CAPACITY)
+    return false;
+
+  // The free-running counters only map onto the slots consistently
+  // if the capacity is a power of two.
+  if(aCapacity & (aCapacity - 1))
+    return false;
+
+  _Slots   = aSlots;
+  _Mask    = aCapacity - 1;
+  _Head    = 0;
+  _Tail    = 0;
+  _Dropped = 0;
+
+  for(byte i=0; i<aCapacity; i++)
+    _Slots[i].Ready = 0;
+
+  return true;
+}
+
+//
+// Reserves the next slot.
+//
+// The AVR has no compare-and-swap, so the check and increment are made
+// with interrupts held off for a handful of cycles; interrupts are the
+// only other producers there can be. Elsewhere a compare-and-swap loop
+// is used and no producer ever waits on another.
+//
+RawFrame* RawFrameQueue::Claim()
+{
+  if(_Slots == NULL)
+    return NULL;
+
+  QueueCounter tail;
+
+#if defined(__AVR__)
+  bool full = false;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    tail = _Tail;
+    if((QueueCounter)(tail - _Head) > _Mask)
+    {
+      _Dropped++;
+      full = true;
+    }
+    else
+      _Tail = tail + 1;
+  }
+
+  if(full)
+    return NULL;
+#else
+  tail = __atomic_load_n(&_Tail, __ATOMIC_RELAXED);
+  do
+  {
+    if((QueueCounter)(tail - __atomic_load_n(&_Head, __ATOMIC_ACQUIRE)) > _Mask)
+    {
+      __atomic_fetch_add(&_Dropped, 1, __ATOMIC_RELAXED);
+      return NULL;
+    }
+  }
+  while(!__atomic_compare_exchange_n(&_Tail, &tail, (QueueCounter)(tail + 1), true,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+#endif
+
+  RawFrame* frame = &_Slots[tail & _Mask];
+  frame->Count = MAX_NUM_ANALOGUE_INPUTS;
+  return frame;
+}
+
+void RawFrameQueue::Commit(RawFrame* aFrame)
+{
+#if defined(__AVR__)
+  aFrame->Ready = 1;
+#else
+  __atomic_store_n(&aFrame->Ready, 1, __ATOMIC_RELEASE);
+#endif
+}
+
+bool RawFrameQueue::Push(byte aSource, const int aValues[], byte aCount)
+{
+  RawFrame* frame = Claim();
+  if(frame == NULL)
+    return false;
+
+  if(aCount > MAX_NUM_ANALOGUE_INPUTS)
+    aCount = MAX_NUM_ANALOGUE_INPUTS;
+
+  frame->Source = aSource;
+  frame->Count  = aCount;
+  for(byte i=0; i<aCount; i++)
+    frame->Values[i] = aValues[i];
+
+  Commit(frame);
+  return true;
+}
+
+byte RawFrameQueue::Drain(DataNormalizer* aNormalizers[], byte aNormalizerCount, byte aMaxBatch,
+                          NormalizedFrameHandler aHandler)
+{
+  if(_Slots == NULL)
+    return 0;
+
+  // Only this function moves _Head, so it is read once and published once
+  // per batch rather than once per frame.
+  QueueCounter head = _Head;
+  byte done = 0;
+
+  while(done < aMaxBatch)
+  {
+    RawFrame* frame = &_Slots[head & _Mask];
+
+    // Either the queue is empty or the producer that claimed this slot
+    // has not finished with it yet; in both cases stop here.
+#if defined(__AVR__)
+    if(!frame->Ready)
+      break;
+#else
+    if(!__atomic_load_n(&frame->Ready, __ATOMIC_ACQUIRE))
+      break;
+#endif
+
+    byte source = frame->Source;
+    if(source < aNormalizerCount && aNormalizers[source] != NULL)
+    {
+      DataNormalizer* normalizer = aNormalizers[source];
+      byte count = normalizer->SensorCount();
+      if(count > frame->Count)
+        count = frame->Count;
+
+      for(byte i=0; i<count; i++)
+        normalizer->Values[i] = frame->Values[i];
+
+      if(normalizer->Normalize() && aHandler)
+        aHandler(source, *normalizer);
+    }
+
+    frame->Ready = 0;
+    head++;
+    done++;
+  }
+
+#if defined(__AVR__)
+  _Head = head;
+#else
+  __atomic_store_n(&_Head, head, __ATOMIC_RELEASE);
+#endif
+
+  if(_Metrics)
+  {
+    _Metrics->BeginUpdate();
+    _Metrics->QueueDepth   = Depth();
+    _Metrics->QueueDropped = _Dropped;
+    _Metrics->EndUpdate();
+  }
+
+  return done;
+}
+
@@ -0,0 +1,164 @@
+//
+//  RawFrameQueue.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef RAW_FRAME_QUEUE_H
+#define RAW_FRAME_QUEUE_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+class NormalizerMetrics;
+
+//
+// One frame of raw readings waiting to be normalized.
+//
+// Source selects the normalizer (and so the calibration data) that the
+// frame is meant for. Count is the number of Values the producer filled
+// in. Ready is set by the producer once the frame is complete and cleared
+// by the consumer once it has been used.
+//
+struct RawFrame
+{
+  volatile byte Ready;
+  byte Source;
+  byte Count;
+  int Values[MAX_NUM_ANALOGUE_INPUTS];
+};
+
+//
+// The queue's free-running counters. A byte is all the AVR can update in one
+// instruction; elsewhere a wider counter keeps a producer that is preempted
+// for a long time from mistaking a wrapped counter for the one it read.
+//
+#if defined(__AVR__)
+typedef byte QueueCounter;
+#else
+typedef unsigned int QueueCounter;
+#endif
+
+//
+// Called by RawFrameQueue::Drain() after each frame has been normalized.
+//
+typedef void (*NormalizedFrameHandler)(byte aSource, DataNormalizer& aNormalizer);
+
+//
+// SUMMARY
+//
+// A queue of raw frames with many producers and one consumer.
+//
+// PURPOSE
+//
+// Several sources (interrupt handlers, serial links to other boards, the
+// main loop) produce raw frames for a pool of normalizers. The producers
+// never block each other or the consumer: each claims a slot, fills it in
+// at leisure, and marks it ready.
+//
+// USE
+//
+// The caller supplies the slots; their number must be a power of two no
+// larger than 128. When the queue is full, the frame is dropped and
+// counted rather than waited on.
+//
+// The consumer calls Drain() from loop(), which normalizes up to a batch
+// of frames with the normalizer selected by each frame's Source.
+//
+// EXAMPLE
+//
+// RawFrame Slots[16];
+// RawFrameQueue Queue;
+// DataNormalizer* Pool[2] = {&BoardA, &BoardB};
+//
+// Queue.configure(Slots, 16);
+// ...
+// Queue.Push(1, values, 4);            // in an ISR or elsewhere
+// ...
+// Queue.Drain(Pool, 2, 8, OnFrame);    // in loop()
+//
+class RawFrameQueue
+{
+  public:
+    RawFrameQueue() : _Slots(NULL), _Mask(0), _Head(0), _Tail(0), _Dropped(0), _Metrics(NULL) {}
+
+    //
+    // aSlots    - storage for the queued frames.
+    // aCapacity - the number of elements in aSlots; a power of two, <= 128.
+    //
+    // Returns false if the storage is unsuitable.
+    //
+    bool configure(RawFrame aSlots[], byte aCapacity);
+
+    //
+    // Producer side, in two steps for sources that fill a frame gradually.
+    //
+    // Claim() reserves the next slot and returns it, or returns NULL if the
+    // queue is full. The caller fills in Source and Values, then passes the
+    // slot to Commit(). Count starts at MAX_NUM_ANALOGUE_INPUTS; a caller
+    // that fills fewer values lowers it to match.
+    //
+    RawFrame* Claim();
+    void Commit(RawFrame* aFrame);
+
+    //
+    // Producer side, in one step.
+    //
+    // Returns false if the queue is full and the frame was dropped.
+    //
+    bool Push(byte aSource, const int aValues[], byte aCount);
+
+    //
+    // Consumer side.
+    //
+    // Normalizes up to aMaxBatch queued frames, in order, each with
+    // aNormalizers[frame.Source]. Frames for an unknown source are discarded.
+    // Only the values the frame carries are copied; sensors beyond its
+    // Count keep their previous readings.
+    // aHandler, if not NULL, is called after each frame.
+    //
+    // Returns the number of frames taken off the queue.
+    //
+    byte Drain(DataNormalizer* aNormalizers[], byte aNormalizerCount, byte aMaxBatch,
+               NormalizedFrameHandler aHandler);
+
+    // The number of frames claimed but not yet drained.
+    byte Depth() const { return (byte)(QueueCounter)(_Tail - _Head); }
+
+    // The number of frames dropped because the queue was full.
+    unsigned int Dropped() const { return _Dropped; }
+
+    //
+    // Publishes the queue depth and drop count into aMetrics after every
+    // Drain(). Pass NULL to stop.
+    //
+    void AttachMetrics(NormalizerMetrics* aMetrics) { _Metrics = aMetrics; }
+
+  private:
+    RawFrame* _Slots;
+    byte _Mask;
+
+    // Free-running counters; the slot index is the counter masked by _Mask.
+    // _Head is written only by the consumer, _Tail by whichever producer
+    // claims a slot.
+    volatile QueueCounter _Head;
+    volatile QueueCounter _Tail;
+
+    volatile unsigned int _Dropped;
+
+    NormalizerMetrics* _Metrics;
+};
+
+#endif // RAW_FRAME_QUEUE_H
+
@@ -0,0 +1,111 @@
+/*
+ *  ScanPlanner.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "ScanPlanner.h"
+
+ScanPlanner::ScanPlanner()
+  : _OrderLength(0), _Descending(false), _LastPin(0), _LastValue(0), _Primed(false)
+{
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    _Tolerances[i] = SETTLE_ALWAYS;
+    _Order[i] = i;
+  }
+
+  ResetStatistics();
+}
+
+void ScanPlanner::SetTolerance(byte aIndex, int aTolerance)
+{
+  if(aIndex < MAX_NUM_ANALOGUE_INPUTS)
+    _Tolerances[aIndex] = aTolerance < 0 ? 0 : aTolerance;
+}
+
+void ScanPlanner::ResetStatistics()
+{
+  _Conversions     = 0;
+  _Discards        = 0;
+  _DiscardsAvoided = 0;
+}
+
+//
+// Sorting by value gives the path through the readings with the smallest
+// total step; reversing it every other frame removes the jump from the
+// highest reading back to the lowest at the frame boundary.
+//
+void ScanPlanner::Plan(const int aValues[], byte aCount, byte aMask)
+{
+  _OrderLength = 0;
+  for(byte i=0; i<aCount; i++)
+    if(aMask & (1 << i))
+      _Order[_OrderLength++] = i;
+
+  // Insertion sort; there are at most a handful of sensors.
+  for(byte i=1; i<_OrderLength; i++)
+  {
+    byte sensor = _Order[i];
+    byte j = i;
+    while(j > 0 && (_Descending ? aValues[_Order[j-1]] < aValues[sensor]
+                                : aValues[_Order[j-1]] > aValues[sensor]))
+    {
+      _Order[j] = _Order[j-1];
+      j--;
+    }
+    _Order[j] = sensor;
+  }
+
+  _Descending = !_Descending;
+}
+
+void ScanPlanner::Scan(BaseAnalogRead* aInputs[], int aValues[], byte aCount, byte aMask)
+{
+  Plan(aValues, aCount, aMask);
+
+  for(byte k=0; k<_OrderLength; k++)
+  {
+    byte i = _Order[k];
+    BaseAnalogRead* input = aInputs[i];
+    byte pin = input->PinNumber();
+
+    // Until one full scan has been made there is nothing to predict the
+    // step from, so every sensor that may need a throwaway gets one.
+    if(_Tolerances[i] != SETTLE_ALWAYS && (!_Primed || pin != _LastPin))
+    {
+      long step = (long)aValues[i] - _LastValue;
+      if(step < 0)
+        step = -step;
+
+      // A tolerance of 0 discards on every pin change, even with no step.
+      if(!_Primed || _Tolerances[i] == 0 || step > _Tolerances[i])
+      {
+        input->Read();
+        _Discards++;
+      }
+      else
+        _DiscardsAvoided++;
+    }
+
+    aValues[i] = input->Read();
+    _Conversions++;
+
+    _LastPin   = pin;
+    _LastValue = aValues[i];
+  }
+
+  _Primed = true;
+}
+
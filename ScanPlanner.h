@@ -0,0 +1,112 @@
+//
+//  ScanPlanner.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef SCAN_PLANNER_H
+#define SCAN_PLANNER_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+// A settling tolerance meaning "never needs a throwaway conversion".
+const int SETTLE_ALWAYS = 0x7FFF;
+
+//
+// SUMMARY
+//
+// Chooses the order in which DataNormalizer::Read() converts its sensors,
+// and which conversions must be thrown away.
+//
+// PURPOSE
+//
+// The ADC's sample-and-hold capacitor keeps some of the previous channel's
+// voltage. A high-impedance sensor cannot recharge it within one sampling
+// period, so its first reading after a large change is wrong and the usual
+// cure is to discard one conversion on every switch. Most of those are not
+// needed: the error is proportional to the step from the previous voltage.
+//
+// USE
+//
+// Each sensor is given a tolerance: the largest step, in raw counts, that
+// it follows within one conversion. Sensors are converted in order of their
+// previous readings, alternately ascending and descending from frame to
+// frame, so that each step (including the one between frames) is as small
+// as possible. A throwaway conversion is issued only where the predicted
+// step exceeds the sensor's tolerance.
+//
+// The default tolerance of SETTLE_ALWAYS means the sensor never needs one;
+// a tolerance of 0 restores the discard-on-every-switch behaviour.
+//
+// Pipelined reads (see AsyncAnalogRead) do not use the planner.
+//
+// EXAMPLE
+//
+// ScanPlanner Planner;
+// Planner.SetTolerance(2, 40);      // sensor 2 is a high-impedance LDR
+// Sensors.AttachScanPlanner(&Planner);
+//
+class ScanPlanner
+{
+  public:
+    ScanPlanner();
+
+    // Sets the tolerance of sensor aIndex, in raw counts.
+    void SetTolerance(byte aIndex, int aTolerance);
+    int Tolerance(byte aIndex) { return _Tolerances[aIndex]; }
+
+    //
+    // Converts the sensors in aMask (bit i for sensor i) into aValues, which
+    // on entry hold the previous readings. Called by DataNormalizer::Read().
+    //
+    void Scan(BaseAnalogRead* aInputs[], int aValues[], byte aCount, byte aMask);
+
+    // The order used by the latest scan, and the number of sensors in it.
+    byte ScanOrder(byte aPosition) { return _Order[aPosition]; }
+    byte ScanLength() { return _OrderLength; }
+
+    // Conversions kept, thrown away, and the throwaways that a discard on
+    // every switch would have cost in addition.
+    unsigned long Conversions() { return _Conversions; }
+    unsigned long Discards() { return _Discards; }
+    unsigned long DiscardsAvoided() { return _DiscardsAvoided; }
+
+    void ResetStatistics();
+
+  private:
+    // Orders the sensors in aMask by their previous values.
+    void Plan(const int aValues[], byte aCount, byte aMask);
+
+    int _Tolerances[MAX_NUM_ANALOGUE_INPUTS];
+    byte _Order[MAX_NUM_ANALOGUE_INPUTS];
+    byte _OrderLength;
+
+    // Scan direction of the next frame.
+    bool _Descending;
+
+    // The pin and value of the last conversion made by the planner.
+    byte _LastPin;
+    int _LastValue;
+
+    // True once a full scan has been made.
+    bool _Primed;
+
+    unsigned long _Conversions;
+    unsigned long _Discards;
+    unsigned long _DiscardsAvoided;
+};
+
+#endif // SCAN_PLANNER_H
+
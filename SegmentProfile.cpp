@@ -0,0 +1,167 @@
+/*
+ *  SegmentProfile.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "SegmentProfile.h"
+
+const byte DEFAULT_PROBE_DEPTH = 3;
+
+SegmentProfile::SegmentProfile()
+  : _Hits(NULL), _Order(NULL), _Outcomes(0), _ProbeDepth(DEFAULT_PROBE_DEPTH), _Learning(true), _Built(false),
+    _Searches(0), _Probes(0)
+{
+}
+
+bool SegmentProfile::configure(unsigned int aHits[], byte aOrder[], byte aOutcomes)
+{
+  if(aHits == NULL || aOrder == NULL || aOutcomes < 3)
+    return false;
+
+  _Hits     = aHits;
+  _Order    = aOrder;
+  _Outcomes = aOutcomes;
+
+  Reset();
+  return true;
+}
+
+void SegmentProfile::Reset()
+{
+  for(byte k=0; k<_Outcomes; k++)
+  {
+    _Hits[k]  = 0;
+    _Order[k] = k;
+  }
+
+  _Built    = false;
+  _Searches = 0;
+  _Probes   = 0;
+}
+
+//
+// Outcome k covers the raw values above breakpoint k-1 and up to and
+// including breakpoint k, with open ends for the first and last outcomes.
+// It corresponds to position k-1 of the plain search, except that the last
+// outcome is reported as aSize.
+//
+bool SegmentProfile::Holds(byte aOutcome, int aValue, const int* aVector, byte aSize)
+{
+  return (aOutcome == 0 || aValue > aVector[aOutcome-1])
+      && (aOutcome == aSize || aValue <= aVector[aOutcome]);
+}
+
+char SegmentProfile::PlainPosition(int aValue, const int* aVector, byte aSize)
+{
+  byte i;
+  for(i=0; i<aSize; i++)
+    if(aValue <= aVector[i])
+      return i-1;
+
+  return aSize;
+}
+
+char SegmentProfile::FindPosition(int aValue, const int* aVector, byte aSize)
+{
+  // A profile built for another vector size is no use.
+  if(_Hits == NULL || aSize + 1 != _Outcomes)
+    return PlainPosition(aValue, aVector, aSize);
+
+  _Searches++;
+
+  byte outcome = _Outcomes;
+
+  // Until Rebuild() has run the order is the plain one, so probing it
+  // would only repeat the plain search's first steps.
+  byte depth = !_Built ? 0 : _ProbeDepth < _Outcomes ? _ProbeDepth : _Outcomes;
+
+  for(byte k=0; k<depth; k++)
+  {
+    _Probes++;
+    if(Holds(_Order[k], aValue, aVector, aSize))
+    {
+      outcome = _Order[k];
+      break;
+    }
+  }
+
+  if(outcome == _Outcomes)
+  {
+    char position = PlainPosition(aValue, aVector, aSize);
+    outcome = position == aSize ? aSize : position + 1;
+    _Probes += outcome + 1;
+  }
+
+  if(_Learning)
+  {
+    // Keep the counts in proportion rather than letting one saturate.
+    if(_Hits[outcome] == 0xFFFF)
+      for(byte k=0; k<_Outcomes; k++)
+        _Hits[k] >>= 1;
+
+    _Hits[outcome]++;
+  }
+
+  return outcome == aSize ? aSize : outcome - 1;
+}
+
+void SegmentProfile::Rebuild()
+{
+  if(_Hits == NULL)
+    return;
+
+  // Insertion sort, highest count first. Ties keep ascending order so that
+  // an unprofiled sensor searches as the plain search does.
+  for(byte k=0; k<_Outcomes; k++)
+    _Order[k] = k;
+
+  for(byte k=1; k<_Outcomes; k++)
+  {
+    byte outcome = _Order[k];
+    byte j = k;
+    while(j > 0 && _Hits[_Order[j-1]] < _Hits[outcome])
+    {
+      _Order[j] = _Order[j-1];
+      j--;
+    }
+    _Order[j] = outcome;
+  }
+
+  for(byte k=0; k<_Outcomes; k++)
+    _Hits[k] >>= 1;
+
+  _Built = true;
+}
+
+bool SegmentProfile::Verify(const int* aVector, byte aSize, int aFrom, int aTo)
+{
+  bool learning = _Learning;
+  unsigned long searches = _Searches;
+  unsigned long probes = _Probes;
+
+  _Learning = false;
+
+  bool same = true;
+  for(long value=aFrom; value<=aTo && same; value++)
+    if(FindPosition(value, aVector, aSize) != PlainPosition(value, aVector, aSize))
+      same = false;
+
+  _Learning = learning;
+  _Searches = searches;
+  _Probes   = probes;
+
+  return same;
+}
+
@@ -0,0 +1,127 @@
+//
+//  SegmentProfile.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef SEGMENT_PROFILE_H
+#define SEGMENT_PROFILE_H
+
+#include "Arduino.h"
+
+//
+// SUMMARY
+//
+// Searches a sensor's calibration segments in order of how often each has
+// been hit, rather than from the lowest breakpoint up.
+//
+// PURPOSE
+//
+// Readings are rarely spread evenly: a sensor pointed at the sky spends
+// most of its time in two or three segments. Trying those first finds the
+// segment in one or two comparisons however long the calibration vector is.
+//
+// USE
+//
+// There are aVectorSize + 1 outcomes of a search: below the first
+// breakpoint, each of the aVectorSize - 1 segments, and above the last
+// breakpoint. The caller supplies a hit count and an order slot for each.
+//
+// While learning, every search counts its outcome. Rebuild() sorts the
+// outcomes by their counts and halves the counts, so that the order follows
+// changes in the scene; call it whenever convenient, say once a minute.
+// Only the first ProbeDepth outcomes of the order are tried; if none match,
+// the ordinary search from the bottom is used, so results are always the
+// same as without the profile. Verify() checks this over a range of raw
+// values.
+//
+// EXAMPLE
+//
+// unsigned int Hits[VECTOR_SIZE + 1];
+// byte Order[VECTOR_SIZE + 1];
+// SegmentProfile Profile;
+//
+// Profile.configure(Hits, Order, VECTOR_SIZE + 1);
+// Sensors.AttachProfile(0, &Profile);
+// ...
+// Profile.Rebuild();
+//
+class SegmentProfile
+{
+  public:
+    SegmentProfile();
+
+    //
+    // aHits     - a hit count for each outcome.
+    // aOrder    - the search order, one element for each outcome.
+    // aOutcomes - the number of elements in each; the vector size plus one.
+    //
+    // Returns false if the storage is unsuitable.
+    //
+    bool configure(unsigned int aHits[], byte aOrder[], byte aOutcomes);
+
+    // The number of outcomes tried before falling back to the plain search.
+    void SetProbeDepth(byte aDepth) { _ProbeDepth = aDepth; }
+
+    // Whether searches count their outcomes.
+    void SetLearning(bool aLearning) { _Learning = aLearning; }
+
+    //
+    // Finds the segment of aValue in aVector, which has aSize elements.
+    //
+    // Returns the same as the plain search: < 0 below the breakpoints,
+    // 0..aSize-2 for a segment, aSize above the breakpoints.
+    //
+    char FindPosition(int aValue, const int* aVector, byte aSize);
+
+    //
+    // The plain search from the lowest breakpoint.
+    //
+    static char PlainPosition(int aValue, const int* aVector, byte aSize);
+
+    // Derives the search order from the hit counts, then halves the counts.
+    void Rebuild();
+
+    // Zeroes the hit counts and returns to the plain order.
+    void Reset();
+
+    //
+    // Checks that FindPosition() and PlainPosition() agree for every raw value
+    // from aFrom to aTo inclusive. Hit counts are left untouched.
+    //
+    bool Verify(const int* aVector, byte aSize, int aFrom, int aTo);
+
+    // Searches made, and the comparisons they needed between them.
+    unsigned long Searches() { return _Searches; }
+    unsigned long Probes() { return _Probes; }
+
+  private:
+    // Does outcome aOutcome hold aValue?
+    static bool Holds(byte aOutcome, int aValue, const int* aVector, byte aSize);
+
+    unsigned int* _Hits;
+    byte* _Order;
+    byte _Outcomes;
+    byte _ProbeDepth;
+    bool _Learning;
+
+    // True once Rebuild() has derived an order.
+    bool _Built;
+
+    unsigned long _Searches;
+    unsigned long _Probes;
+};
+
+#endif // SEGMENT_PROFILE_H
+
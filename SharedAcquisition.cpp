@@ -0,0 +1,89 @@
+/*
+ *  SharedAcquisition.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "SharedAcquisition.h"
+
+bool SharedAcquisition::Subscribe(DataNormalizer* aNormalizer)
+{
+  if(aNormalizer == NULL || aNormalizer->StatusCode() != DataNormalizer::S_OK)
+    return false;
+
+  if(_SubscriberCount >= MAX_SHARED_SUBSCRIBERS)
+    return false;
+
+  _Subscribers[_SubscriberCount++] = aNormalizer;
+  return true;
+}
+
+//
+// Each reader is converted where it is first met. Later uses look back
+// over the sensors already visited for the same reader and copy its value.
+// With at most a few dozen sensors the search costs far less than the
+// conversion it saves, and it needs no table to keep up to date.
+//
+void SharedAcquisition::Read()
+{
+  for(byte s=0; s<_SubscriberCount; s++)
+  {
+    DataNormalizer* normalizer = _Subscribers[s];
+    byte count = normalizer->SensorCount();
+
+    for(byte i=0; i<count; i++)
+    {
+      if(!normalizer->Enabled(i))
+        continue;
+
+      BaseAnalogRead* input = normalizer->Input(i);
+      bool found = false;
+
+      for(byte t=0; t<=s && !found; t++)
+      {
+        DataNormalizer* earlier = _Subscribers[t];
+        byte limit = t < s ? earlier->SensorCount() : i;
+
+        for(byte j=0; j<limit; j++)
+          if(earlier->Input(j) == input && earlier->Enabled(j))
+          {
+            normalizer->Values[i] = earlier->Values[j];
+            found = true;
+            break;
+          }
+      }
+
+      if(found)
+        _ConversionsShared++;
+      else
+      {
+        normalizer->Values[i] = input->Read();
+        _Conversions++;
+      }
+    }
+  }
+}
+
+bool SharedAcquisition::ReadAndNormalize()
+{
+  Read();
+
+  bool ok = true;
+  for(byte s=0; s<_SubscriberCount; s++)
+    if(!_Subscribers[s]->Normalize())
+      ok = false;
+
+  return ok;
+}
+
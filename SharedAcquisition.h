@@ -0,0 +1,95 @@
+//
+//  SharedAcquisition.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef SHARED_ACQUISITION_H
+#define SHARED_ACQUISITION_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+// The most normalizers one SharedAcquisition can serve.
+const byte MAX_SHARED_SUBSCRIBERS = 4;
+
+//
+// SUMMARY
+//
+// Reads the sensors of several normalizers, converting each reader once.
+//
+// PURPOSE
+//
+// Two normalizers may share a BaseAnalogRead, for instance to report one
+// light sensor both in f/stops and in lux. Calling ReadAndNormalize() on
+// each converts that sensor twice. The shared acquisition converts it once
+// per frame and hands the reading to every normalizer that uses it.
+//
+// USE
+//
+// Readers are matched by object, not by pin, since two readers on one pin
+// may deliberately differ (one averaging, say). Samplers and scan planners
+// attached to the subscribers are not consulted.
+//
+// EXAMPLE
+//
+// SharedAcquisition Acquisition;
+// Acquisition.Subscribe(&FStops);
+// Acquisition.Subscribe(&Lux);
+// ...
+// Acquisition.ReadAndNormalize();
+//
+class SharedAcquisition
+{
+  public:
+    SharedAcquisition() : _SubscriberCount(0), _Conversions(0), _ConversionsShared(0) {}
+
+    //
+    // Adds aNormalizer to the set served. It must already be configured.
+    //
+    // Returns false if it is not configured or the set is full.
+    //
+    bool Subscribe(DataNormalizer* aNormalizer);
+
+    // Removes every subscriber.
+    void Clear() { _SubscriberCount = 0; }
+
+    //
+    // Fills the Values array of every subscriber.
+    //
+    void Read();
+
+    //
+    // Calls Read(), then Normalize() on every subscriber.
+    //
+    // Returns false if any subscriber failed to normalize.
+    //
+    bool ReadAndNormalize();
+
+    byte SubscriberCount() { return _SubscriberCount; }
+
+    // Conversions made, and conversions saved by sharing.
+    unsigned long Conversions() { return _Conversions; }
+    unsigned long ConversionsShared() { return _ConversionsShared; }
+
+  private:
+    DataNormalizer* _Subscribers[MAX_SHARED_SUBSCRIBERS];
+    byte _SubscriberCount;
+
+    unsigned long _Conversions;
+    unsigned long _ConversionsShared;
+};
+
+#endif // SHARED_ACQUISITION_H
+
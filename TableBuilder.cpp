@@ -0,0 +1,93 @@
+/*
+ *  TableBuilder.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "TableBuilder.h"
+
+TableBuilder::TableBuilder()
+  : _Normalizer(NULL), _Low(0), _Pending(0), _Built(0), _Current(0), _Next(0)
+{
+}
+
+bool TableBuilder::Begin(DataNormalizer& aNormalizer, byte aSensors, int aLow)
+{
+  if(aNormalizer.StatusCode() != DataNormalizer::S_OK)
+    return false;
+
+  _Normalizer = &aNormalizer;
+  _Low        = aLow;
+  _Pending    = 0;
+  _Built      = 0;
+  _Current    = 0;
+  _Next       = 0;
+
+  for(byte i=0; i<aNormalizer.SensorCount(); i++)
+  {
+    CompensationMemo* memo = aNormalizer.Memo(i);
+    if(!(aSensors & (1 << i)) || memo == NULL || !aNormalizer.Present(i))
+      continue;
+
+    // Out of use first, so the normalizer never sees a half-built memo.
+    memo->SetReady(false);
+    memo->Clear();
+    _Pending |= 1 << i;
+  }
+
+  return true;
+}
+
+bool TableBuilder::Step(unsigned int aEntries)
+{
+  while(_Pending && aEntries > 0)
+  {
+    while(!(_Pending & (1 << _Current)))
+      _Current++;
+
+    // The sensor may have been removed, or its memo detached, since the
+    // last step; then there is nothing left to build for it.
+    CompensationMemo* memo = _Normalizer->Present(_Current) ? _Normalizer->Memo(_Current) : NULL;
+    if(memo == NULL || _Normalizer->StatusCode() != DataNormalizer::S_OK)
+    {
+      _Pending &= ~(1 << _Current);
+      _Next     = 0;
+      continue;
+    }
+
+    unsigned int capacity = memo->Capacity();
+
+    for(; _Next < capacity && aEntries > 0; _Next++, aEntries--)
+    {
+      long raw = (long)_Low + _Next;
+      if(raw > 32767)
+        break;
+
+      int segment;
+      int value = _Normalizer->NormalizeValue(_Current, raw, &segment);
+      memo->Store(raw, value, segment);
+    }
+
+    if(aEntries == 0 && _Next < capacity && (long)_Low + _Next <= 32767)
+      break;
+
+    memo->SetReady(true);
+    _Built   |= 1 << _Current;
+    _Pending &= ~(1 << _Current);
+    _Next     = 0;
+  }
+
+  return _Pending == 0;
+}
+
@@ -0,0 +1,101 @@
+//
+//  TableBuilder.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef TABLE_BUILDER_H
+#define TABLE_BUILDER_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+#include "CompensationMemo.h"
+
+//
+// SUMMARY
+//
+// Fills a normalizer's memos a little at a time, without delaying the first
+// frames.
+//
+// PURPOSE
+//
+// A memo filled as readings arrive misses on every new reading, so frame
+// times vary until it has seen them all; filling every memo in setup()
+// delays the first frame instead. The builder fills the memos in small
+// steps from loop(). Until a sensor's memo is complete, that sensor is
+// normalized the ordinary way, and then it switches over to the memo.
+//
+// USE
+//
+// Begin() takes the sensors whose attached memos should be built. Each
+// memo is filled for the Capacity() consecutive readings starting at aLow,
+// one reading per entry, so with a memo as large as the ADC's range it
+// becomes a complete lookup table.
+//
+// Step() fills up to aEntries entries and returns true once every memo is
+// built. A memo is marked Ready() as soon as it is complete, so sensors
+// switch over one by one. The switch is a single flag, so a Normalize()
+// running in an interrupt sees either the finished memo or none.
+//
+// Calling configure() on the normalizer while building, or attaching a
+// memo to a sensor that is being built, clears the memos concerned and puts
+// them back in use as ordinary memos; call Begin() again to rebuild. A
+// sensor that is removed, or whose memo is detached, is dropped from the
+// build at the next Step() and never marked built.
+//
+// EXAMPLE
+//
+// TableBuilder Builder;
+// Builder.Begin(Sensors, 0x0F);   // sensors 0..3
+// ...
+// Builder.Step(32);               // in loop()
+//
+class TableBuilder
+{
+  public:
+    TableBuilder();
+
+    //
+    // Starts building the memos of the sensors in aSensors (bit i for
+    // sensor i). Sensors without a memo are ignored.
+    //
+    // Returns false if the normalizer is not configured.
+    //
+    bool Begin(DataNormalizer& aNormalizer, byte aSensors, int aLow = 0);
+
+    //
+    // Fills up to aEntries entries. Returns true once every memo is built.
+    //
+    bool Step(unsigned int aEntries);
+
+    // Sensors whose memos are built, one bit per sensor, and whether all are.
+    byte ReadyMask() { return _Built; }
+    bool Done() { return _Pending == 0; }
+
+    // True if sensor aIndex's memo was built by this builder.
+    bool Ready(byte aIndex) { return _Built & (1 << aIndex); }
+
+  private:
+    DataNormalizer* _Normalizer;
+    int _Low;
+
+    // Sensors left to build, those built, and progress on the current one.
+    byte _Pending;
+    byte _Built;
+    byte _Current;
+    unsigned int _Next;
+};
+
+#endif // TABLE_BUILDER_H
+
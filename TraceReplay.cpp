@@ -0,0 +1,92 @@
+/*
+ *  TraceReplay.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "TraceReplay.h"
+
+TraceReplay::TraceReplay()
+  : _Storage(NULL), _Capacity(0), _Interval(0), _Count(0), _Warmup(0)
+{
+}
+
+bool TraceReplay::configure(ReplayCheckpoint aStorage[], unsigned int aCapacity, unsigned int aInterval)
+{
+  if(aStorage == NULL || aCapacity == 0 || aInterval == 0)
+    return false;
+
+  _Storage  = aStorage;
+  _Capacity = aCapacity;
+  _Interval = aInterval;
+  _Count    = 0;
+  return true;
+}
+
+bool TraceReplay::Record(DataNormalizer& aNormalizer, unsigned long aFrame)
+{
+  if(_Count >= _Capacity || aFrame % _Interval != 0)
+    return false;
+
+  if(_Count > 0 && aFrame <= _Storage[_Count-1].Frame)
+    return false;
+
+  _Storage[_Count].Frame = aFrame;
+  aNormalizer.SaveState(_Storage[_Count].State);
+  _Count++;
+  return true;
+}
+
+unsigned int TraceReplay::Replay(DataNormalizer& aNormalizer, const int aTrace[], unsigned long aFirst, unsigned int aCount, int aOut[])
+{
+  if(aNormalizer.StatusCode() != DataNormalizer::S_OK)
+    return 0;
+
+  // The latest checkpoint at or before aFirst; they are in frame order.
+  const ReplayCheckpoint* checkpoint = NULL;
+  for(unsigned int k=0; k<_Count && _Storage[k].Frame <= aFirst; k++)
+    checkpoint = &_Storage[k];
+
+  unsigned long frame;
+  if(checkpoint)
+  {
+    if(!aNormalizer.RestoreState(checkpoint->State))
+      return 0;
+    frame = checkpoint->Frame;
+  }
+  else
+    frame = aFirst > _Warmup ? aFirst - _Warmup : 0;
+
+  const byte count = aNormalizer.SensorCount();
+  const unsigned long end = aFirst + aCount;
+
+  for(; frame < end; frame++)
+  {
+    const int* raw = aTrace + frame * count;
+    for(byte i=0; i<count; i++)
+      aNormalizer.Values[i] = raw[i];
+
+    aNormalizer.Normalize();
+
+    if(frame >= aFirst)
+    {
+      int* out = aOut + (frame - aFirst) * count;
+      for(byte i=0; i<count; i++)
+        out[i] = aNormalizer.Normalized[i];
+    }
+  }
+
+  return aCount;
+}
+
@@ -0,0 +1,129 @@
+//
+//  TraceReplay.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef TRACE_REPLAY_H
+#define TRACE_REPLAY_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+
+//
+// A normalizer's state as it was just before frame Frame was normalized.
+//
+struct ReplayCheckpoint
+{
+  unsigned long Frame;
+  NormalizerState State;
+};
+
+//
+// SUMMARY
+//
+// Replays a recorded trace of raw frames in independent chunks that give
+// the same results as one replay from the start.
+//
+// PURPOSE
+//
+// A long trace takes a long time to push through Normalize() in one go, and
+// it cannot simply be cut up: shed sensors hold their previous values and
+// the shedding follows a frame counter, so each frame can depend on the ones
+// before it. Checkpoints of the normalizer's state, taken every so
+// many frames while the trace is captured, let any chunk start where a
+// checkpoint was taken and run on its own. Chunks can then be handed to
+// separate normalizers, cores or machines.
+//
+// USE
+//
+// While capturing, call Record() before normalizing each frame. A checkpoint
+// is kept every Interval() frames, until the storage is full.
+//
+// To replay frames aFirst to aFirst+aCount-1, Replay() restores the latest
+// checkpoint at or before aFirst and normalizes forward from there, writing
+// only the requested frames to aOut. Without a checkpoint it starts
+// SetWarmup() frames early instead. That is exact from frame 0, and
+// otherwise exact only if nothing depends on frames further back than the
+// warm-up.
+//
+// Derived channels are not part of the state, so a program that reads a
+// channel before storing it this frame is only exact from frame 0.
+//
+// The normalizer used for each chunk must be configured and attached as the
+// one used for the serial replay was. Each chunk needs its own normalizer if
+// chunks run at the same time.
+//
+// EXAMPLE
+//
+// ReplayCheckpoint Checkpoints[32];
+// TraceReplay Replay;
+// Replay.configure(Checkpoints, 32, 256);
+//
+// // Capture
+// Replay.Record(Sensors, Frame);
+// Sensors.Normalize();
+//
+// // Later, a chunk of 256 frames
+// Replay.Replay(Worker, Trace, 1024, 256, Out);
+//
+class TraceReplay
+{
+  public:
+    TraceReplay();
+
+    //
+    // aStorage  - where checkpoints are kept.
+    // aCapacity - the number of elements in aStorage.
+    // aInterval - the number of frames between checkpoints.
+    //
+    bool configure(ReplayCheckpoint aStorage[], unsigned int aCapacity, unsigned int aInterval);
+
+    // The number of frames replayed before a chunk when there is no checkpoint.
+    void SetWarmup(unsigned int aFrames) { _Warmup = aFrames; }
+
+    //
+    // Keeps a checkpoint of aNormalizer if frame aFrame is due one. Frames
+    // must be recorded in increasing order.
+    //
+    // Returns true if a checkpoint was taken.
+    //
+    bool Record(DataNormalizer& aNormalizer, unsigned long aFrame);
+
+    //
+    // Normalizes frames aFirst to aFirst+aCount-1 of aTrace, which holds
+    // interleaved raw frames from frame 0 on, and writes them interleaved to
+    // aOut. Frames before aFirst are replayed as needed but not written.
+    //
+    // Returns the number of frames written, or 0 if the normalizer is not
+    // configured or its state cannot be restored.
+    //
+    unsigned int Replay(DataNormalizer& aNormalizer, const int aTrace[], unsigned long aFirst, unsigned int aCount, int aOut[]);
+
+    unsigned int Interval() { return _Interval; }
+    unsigned int Checkpoints() { return _Count; }
+
+    // Forget every checkpoint.
+    void Clear() { _Count = 0; }
+
+  private:
+    ReplayCheckpoint* _Storage;
+    unsigned int _Capacity;
+    unsigned int _Interval;
+    unsigned int _Count;
+    unsigned int _Warmup;
+};
+
+#endif // TRACE_REPLAY_H
+
@@ -0,0 +1,178 @@
+/*
+ *  WarmStart.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "WarmStart.h"
+
+//
+// Layout:
+//
+//   0  'W' 'S'
+//   2  version
+//   3  flags, bit 0 set if the sampler state follows
+//   4  payload length
+//   6  fingerprint
+//   8  payload
+//  ..  checksum of everything before it
+//
+static const byte WARM_START_HEADER  = 8;
+static const byte WARM_START_SAMPLER = 0x01;
+
+// NormalizerState: two bytes, then three arrays of ints.
+static const byte NORMALIZER_STATE_BYTES = 2 + 3 * 2 * MAX_NUM_ANALOGUE_INPUTS;
+
+// SamplerState: two arrays of bytes, one of ints, then one byte.
+static const byte SAMPLER_STATE_BYTES = 2 * MAX_NUM_ANALOGUE_INPUTS + 2 * MAX_NUM_ANALOGUE_INPUTS + 1;
+
+static void PutWord(byte*& aCursor, unsigned int aValue)
+{
+  *aCursor++ = aValue & 0xFF;
+  *aCursor++ = (aValue >> 8) & 0xFF;
+}
+
+static void PutInt(byte*& aCursor, int aValue)
+{
+  // Only matters where an int is wider than 16 bits.
+  if(aValue > 32767)
+    aValue = 32767;
+  else if(aValue < -32768)
+    aValue = -32768;
+
+  PutWord(aCursor, aValue);
+}
+
+static int GetInt(const byte*& aCursor)
+{
+  long value = aCursor[0] | ((unsigned int)aCursor[1] << 8);
+  aCursor += 2;
+  return value > 32767 ? value - 65536L : value;
+}
+
+unsigned int WarmStart::Checksum(const byte aBuffer[], unsigned int aLength)
+{
+  unsigned int a = 0, b = 0;
+
+  for(unsigned int i=0; i<aLength; i++)
+  {
+    a = (a + aBuffer[i]) % 255;
+    b = (b + a) % 255;
+  }
+
+  return (b << 8) | a;
+}
+
+unsigned int WarmStart::Save(DataNormalizer& aNormalizer, AdaptiveSampler* aSampler, byte aBuffer[], unsigned int aLength)
+{
+  unsigned int payload = NORMALIZER_STATE_BYTES + (aSampler ? SAMPLER_STATE_BYTES : 0);
+  unsigned int total = WARM_START_HEADER + payload + 2;
+
+  if(aNormalizer.StatusCode() != DataNormalizer::S_OK || aBuffer == NULL || aLength < total)
+    return 0;
+
+  byte* p = aBuffer;
+  *p++ = 'W';
+  *p++ = 'S';
+  *p++ = WARM_START_VERSION;
+  *p++ = aSampler ? WARM_START_SAMPLER : 0;
+  PutWord(p, payload);
+  PutWord(p, aNormalizer.Fingerprint());
+
+  NormalizerState state;
+  aNormalizer.SaveState(state);
+
+  *p++ = state.SensorCount;
+  *p++ = state.ShedPhase;
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    PutInt(p, state.Values[i]);
+    PutInt(p, state.Normalized[i]);
+    PutInt(p, state.SegmentBases[i]);
+  }
+
+  if(aSampler)
+  {
+    SamplerState sampler;
+    aSampler->SaveState(sampler);
+
+    for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+    {
+      *p++ = sampler.Intervals[i];
+      *p++ = sampler.QuietRuns[i];
+      PutInt(p, sampler.Previous[i]);
+    }
+    *p++ = sampler.Seen;
+  }
+
+  PutWord(p, Checksum(aBuffer, p - aBuffer));
+  return total;
+}
+
+bool WarmStart::Restore(DataNormalizer& aNormalizer, AdaptiveSampler* aSampler, const byte aBuffer[], unsigned int aLength)
+{
+  if(aNormalizer.StatusCode() != DataNormalizer::S_OK || aBuffer == NULL || aLength < WARM_START_HEADER + 2)
+    return false;
+
+  const byte* p = aBuffer;
+  if(p[0] != 'W' || p[1] != 'S' || p[2] != WARM_START_VERSION)
+    return false;
+
+  byte flags = p[3];
+  p += 4;
+  unsigned int payload = GetInt(p) & 0xFFFF;
+  unsigned int fingerprint = GetInt(p) & 0xFFFF;
+
+  unsigned int expected = NORMALIZER_STATE_BYTES + ((flags & WARM_START_SAMPLER) ? SAMPLER_STATE_BYTES : 0);
+  if(payload != expected || aLength < WARM_START_HEADER + payload + 2)
+    return false;
+
+  const byte* end = aBuffer + WARM_START_HEADER + payload;
+  const byte* sum = end;
+  if((unsigned int)(GetInt(sum) & 0xFFFF) != Checksum(aBuffer, WARM_START_HEADER + payload))
+    return false;
+
+  if(fingerprint != aNormalizer.Fingerprint())
+    return false;
+
+  NormalizerState state;
+  state.SensorCount = *p++;
+  state.ShedPhase   = *p++;
+  for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+  {
+    state.Values[i]       = GetInt(p);
+    state.Normalized[i]   = GetInt(p);
+    state.SegmentBases[i] = GetInt(p);
+  }
+
+  if(!aNormalizer.RestoreState(state))
+    return false;
+
+  if(aSampler && (flags & WARM_START_SAMPLER))
+  {
+    SamplerState sampler;
+    for(byte i=0; i<MAX_NUM_ANALOGUE_INPUTS; i++)
+    {
+      sampler.Intervals[i] = *p++;
+      sampler.QuietRuns[i] = *p++;
+      sampler.Previous[i]  = GetInt(p);
+    }
+    sampler.Seen = *p++;
+
+    aSampler->RestoreState(sampler);
+  }
+
+  return true;
+}
+
@@ -0,0 +1,104 @@
+//
+//  WarmStart.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include "Arduino.h"
+#include "DataNormalizer.h"
+#include "AdaptiveSampler.h"
+
+// Format of the saved image; bumped whenever its layout changes.
+const byte WARM_START_VERSION = 1;
+
+// The largest image Save() writes, in bytes.
+const unsigned int WARM_START_BYTES = 73;
+
+//
+// SUMMARY
+//
+// Saves a normalizer's runtime state to a few bytes, and restores it after
+// a reset.
+//
+// PURPOSE
+//
+// After a reset the normalizer starts cold: no previous readings, segment
+// searches from scratch and an attached sampler converting every sensor at
+// full rate until it has learned again which are quiet. Saving the state
+// now and then, and restoring it at start-up, lets the device carry on
+// where it left off.
+//
+// USE
+//
+// The image holds NormalizerState and, if a sampler is given, its
+// SamplerState, with every value stored as 16 bits little-endian so that
+// an image is portable between targets. On a host, where an int is wider,
+// values outside -32768..32767 are saved at the nearer limit. A header
+// carries a magic number, the format version, the normalizer's
+// Fingerprint() and the length; a Fletcher-16 checksum ends it.
+//
+// Not saved, and so cold after a restore:
+//
+// - CompensationMemo contents. Memos refill as readings arrive, or use a
+//   TableBuilder.
+// - SegmentProfile search orders and hit counts. They are relearned within
+//   a few frames.
+// - The OverloadController level. It follows the backlog, which a reset
+//   empties anyway.
+// - NormalizerMetrics counts, and which sensors are enabled.
+//
+// Restore() checks the header's magic number, version, fingerprint and
+// length, and the checksum, before changing anything, so a missing, stale
+// or damaged image leaves the normalizer cold rather than wrong. An image
+// saved without a sampler restores the normalizer alone.
+//
+// WarmStartEEPROM.h keeps the image in EEPROM. On a host, write the buffer
+// to a file.
+//
+// EXAMPLE
+//
+// byte Image[WARM_START_BYTES];
+// unsigned int Length = WarmStart::Save(Sensors, &Sampler, Image, sizeof(Image));
+// ...
+// WarmStart::Restore(Sensors, &Sampler, Image, Length);
+//
+class WarmStart
+{
+  public:
+    //
+    // Writes the state of aNormalizer and, unless NULL, aSampler to aBuffer.
+    //
+    // Returns the number of bytes written, or 0 if the normalizer is not
+    // configured or aBuffer is too small.
+    //
+    static unsigned int Save(DataNormalizer& aNormalizer, AdaptiveSampler* aSampler, byte aBuffer[], unsigned int aLength);
+
+    //
+    // Restores the state saved in aBuffer to aNormalizer and, if the image
+    // holds one and aSampler is not NULL, to aSampler.
+    //
+    // Returns false, changing nothing, if the image is not valid for
+    // aNormalizer's configuration.
+    //
+    static bool Restore(DataNormalizer& aNormalizer, AdaptiveSampler* aSampler, const byte aBuffer[], unsigned int aLength);
+
+  private:
+    static unsigned int Checksum(const byte aBuffer[], unsigned int aLength);
+};
+
+#endif // WARM_START_H
+
@@ -0,0 +1,54 @@
+/*
+ *  WarmStartEEPROM.cpp
+ *  Sun Tracker
+ *
+ *  Created on 26/10/17.
+ *  Copyright 2026 Sun Tracker contributors.
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ *
+ * https://creativecommons.org/licenses/by-sa/3.0/
+ *
+ * This code is strictly "as is". Use at your own risk.
+ *
+ *
+ */
+
+#include "WarmStartEEPROM.h"
+
+#ifdef WARM_START_EEPROM
+#include <EEPROM.h>
+
+bool WarmStartSave(int aAddress, DataNormalizer& aNormalizer, AdaptiveSampler* aSampler)
+{
+  byte image[WARM_START_BYTES];
+  unsigned int length = WarmStart::Save(aNormalizer, aSampler, image, sizeof(image));
+
+  if(length == 0 || aAddress < 0 || aAddress + length > EEPROM.length())
+    return false;
+
+  for(unsigned int i=0; i<length; i++)
+    EEPROM.update(aAddress + i, image[i]);
+
+  return true;
+}
+
+bool WarmStartLoad(int aAddress, DataNormalizer& aNormalizer, AdaptiveSampler* aSampler)
+{
+  if(aAddress < 0 || aAddress >= EEPROM.length())
+    return false;
+
+  byte image[WARM_START_BYTES];
+  unsigned int length = EEPROM.length() - aAddress;
+  if(length > sizeof(image))
+    length = sizeof(image);
+
+  for(unsigned int i=0; i<length; i++)
+    image[i] = EEPROM.read(aAddress + i);
+
+  return WarmStart::Restore(aNormalizer, aSampler, image, length);
+}
+
+#endif
+
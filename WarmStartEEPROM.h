@@ -0,0 +1,71 @@
+//
+//  WarmStartEEPROM.h
+//  Sun Tracker
+//
+//  Created on 26/10/17.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+#ifndef WARM_START_EEPROM_H
+#define WARM_START_EEPROM_H
+
+#include "WarmStart.h"
+
+// Cores without EEPROM support still build the rest of the library, and
+// WARM_START_EEPROM is left undefined so that sketches can test for it.
+#if defined(__has_include)
+#if __has_include(<EEPROM.h>)
+#define WARM_START_EEPROM
+#endif
+#else
+#define WARM_START_EEPROM
+#endif
+
+//
+// Keeps a WarmStart image in EEPROM, starting at aAddress and taking up to
+// WARM_START_BYTES bytes.
+//
+// Only bytes that differ are written, so saving an unchanged state costs no
+// EEPROM wear. Even so, EEPROM wears out after about 100,000 writes per
+// byte: save every few minutes, or before a planned power-down, not every
+// frame.
+//
+// Both return false on failure; see WarmStart::Save() and Restore(). They
+// are declared only where WARM_START_EEPROM is defined, so a core without
+// EEPROM fails at compile time rather than at link time.
+//
+// The Arduino IDE only adds the EEPROM library to the build, and so only
+// makes <EEPROM.h> visible here, when the sketch itself includes it. The
+// sketch must therefore include <EEPROM.h> before this header; otherwise
+// WARM_START_EEPROM stays undefined even on cores that have EEPROM.
+//
+// EXAMPLE
+//
+// #include <EEPROM.h>
+// #include <WarmStartEEPROM.h>
+// ...
+// void setup()
+// {
+//   ...
+//   WarmStartLoad(0, Sensors, &Sampler);
+// }
+//
+// if(millis() - LastSave > 600000UL)
+//   WarmStartSave(0, Sensors, &Sampler);
+//
+#ifdef WARM_START_EEPROM
+bool WarmStartSave(int aAddress, DataNormalizer& aNormalizer, AdaptiveSampler* aSampler);
+bool WarmStartLoad(int aAddress, DataNormalizer& aNormalizer, AdaptiveSampler* aSampler);
+#endif
+
+#endif // WARM_START_EEPROM_H
+
@@ -0,0 +1,111 @@
+//
+//  PipelinedAcquisition.ino
+//  Sun Tracker
+//
+//  Created on 26/10/18.
+//  Copyright 2026 Sun Tracker contributors.
+//
+// This work is licensed under a Creative Commons
+// Attribution-ShareAlike 3.0 Unported License.
+//
+// https://creativecommons.org/licenses/by-sa/3.0/
+//
+// This code is strictly "as is". Use at your own risk.
+//
+//
+//
+
+//
+// Compares sequential and pipelined ReadAndNormalize() on simulated sensors.
+//
+// The same four SimulatedAnalogRead readers, each taking as long as a Uno
+// conversion, are given to two normalizers: one through the
+// BaseAnalogRead interface, which converts and then normalizes, and one
+// through the AsyncAnalogRead interface, which normalizes each sensor
+// while the next one converts. NormalizerMetrics times both, and the
+// average frame time of each is printed once a second.
+//
+
+#include <DataNormalizer.h>
+#include <AsyncAnalogRead.h>
+#include <NormalizerMetrics.h>
+
+const byte SENSOR_COUNT = 4;
+const byte VECTOR_SIZE  = 5;
+
+// About as long as analogRead() takes on a 16 MHz Uno.
+const unsigned int CONVERSION_MICROS = 104;
+
+const int FRAMES_PER_REPORT = 500;
+
+SimulatedAnalogRead Sensor0(0, CONVERSION_MICROS);
+SimulatedAnalogRead Sensor1(1, CONVERSION_MICROS);
+SimulatedAnalogRead Sensor2(2, CONVERSION_MICROS);
+SimulatedAnalogRead Sensor3(3, CONVERSION_MICROS);
+
+BaseAnalogRead*  SequentialReaders[SENSOR_COUNT] = {&Sensor0, &Sensor1, &Sensor2, &Sensor3};
+AsyncAnalogRead* PipelinedReaders[SENSOR_COUNT]  = {&Sensor0, &Sensor1, &Sensor2, &Sensor3};
+
+const int Calibration0[VECTOR_SIZE] = {0, 180, 420, 700, 1023};
+const int Calibration1[VECTOR_SIZE] = {0, 200, 450, 720, 1023};
+const int Calibration2[VECTOR_SIZE] = {0, 160, 400, 690, 1023};
+const int Calibration3[VECTOR_SIZE] = {0, 210, 460, 740, 1023};
+const int* CalibrationVectors[SENSOR_COUNT] = {Calibration0, Calibration1, Calibration2, Calibration3};
+
+const int NormalizedVector[VECTOR_SIZE] = {0, 250, 500, 750, 1000};
+
+DataNormalizer Sequential;
+DataNormalizer Pipelined;
+
+NormalizerMetrics SequentialMetrics;
+NormalizerMetrics PipelinedMetrics;
+
+//
+// The average time of a whole frame, read and normalize together, in
+// microseconds. Pipelined frames are recorded entirely as read time.
+//
+unsigned long FrameMicros(NormalizerMetrics& aMetrics)
+{
+  NormalizerMetrics copy;
+  if(!aMetrics.Snapshot(copy) || copy.Frames == 0)
+    return 0;
+
+  return (unsigned long)((copy.TotalReadMicros + copy.TotalNormalizeMicros) / copy.Frames);
+}
+
+void setup()
+{
+  Serial.begin(9600);
+
+  Sequential.configure(SENSOR_COUNT, SequentialReaders, VECTOR_SIZE, CalibrationVectors, NormalizedVector);
+  Pipelined.configure(SENSOR_COUNT, PipelinedReaders, VECTOR_SIZE, CalibrationVectors, NormalizedVector);
+
+  Sequential.AttachMetrics(&SequentialMetrics);
+  Pipelined.AttachMetrics(&PipelinedMetrics);
+}
+
+void loop()
+{
+  SequentialMetrics.Reset();
+  PipelinedMetrics.Reset();
+
+  for(int frame=0; frame<FRAMES_PER_REPORT; frame++)
+  {
+    // Something for the normalizers to work on.
+    Sensor0.SetValue(random(1024));
+    Sensor1.SetValue(random(1024));
+    Sensor2.SetValue(random(1024));
+    Sensor3.SetValue(random(1024));
+
+    Sequential.ReadAndNormalize();
+    Pipelined.ReadAndNormalize();
+  }
+
+  Serial.print(F("us per frame, sequential/pipelined: "));
+  Serial.print(FrameMicros(SequentialMetrics));
+  Serial.print('/');
+  Serial.println(FrameMicros(PipelinedMetrics));
+
+  delay(1000);
+}
+